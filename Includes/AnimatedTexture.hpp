@@ -5,6 +5,7 @@
 #define HPP_ANIMATED_TEXTURE_HPP
 
 #include <SDL2/SDL.h>
+#include <Snapshot.hpp>
 #include <Texture.hpp>
 
 /** @class AnimatedTexture
@@ -14,24 +15,41 @@ class AnimatedTexture: public Texture
 {
 	public:
 		/** Create an animated texture.
-		 * @param pointerSDLTexture The SDL texture to use.
+		 * @param pointerSDLTexture The SDL texture to use (it can be NULL in headless mode).
+		 * @param width The whole texture width in pixels (all images included).
+		 * @param height The texture height in pixels.
 		 * @param imagesCount How many single images are present in the provided texture.
 		 * @param framesPerImageCount How many game frames to wait between each single image displaying.
 		 * @param isAnimationLooping Set to true to make the animation loop forever, set to false to display the animation only once.
 		 * @note Texture starts playing from the first image.
 		 */
-		AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping);
+		AnimatedTexture(SDL_Texture *pointerSDLTexture, int width, int height, int imagesCount, int framesPerImageCount, bool isAnimationLooping);
 		
 		/** Free allocated resources. */
 		virtual ~AnimatedTexture() {}
 		
-		/** Render the texture using the main renderer. The provided coordinates indicate texture's top left angle.
+		/** Render the current animation image using the main renderer. The provided coordinates indicate texture's top left angle.
 		 * @param x X coordinate where to draw the texture on the display.
 		 * @param y Y coordinate where to draw the texture on the display.
+		 * @return Always 0.
+		 */
+		virtual int render(int x, int y);
+		
+		/** Advance the animation by one game frame. This is done apart from rendering so animations also progress when nothing is displayed (headless mode).
 		 * @return 0 if the animation is not finished,
 		 * @return 1 if the animation has finished playing (only if the texture was created with isAnimationLooping set to false).
 		 */
-		virtual int render(int x, int y);
+		int update();
+		
+		/** Save the animation progress.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore the animation progress.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		void restoreState(Snapshot *pointerSnapshot);
 	
 	protected:
 		/** How many static images are contained in the provided image file. */
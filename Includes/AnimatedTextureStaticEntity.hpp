@@ -26,11 +26,21 @@ class AnimatedTextureStaticEntity: public StaticEntity
 		// No need for documentation because it is the same as parent function
 		virtual void render();
 		
-		/** Tell whether the animation finished playing.
+		/** Advance the animation and tell whether it finished playing.
 		 * @return 0 while the animation must be displayed,
 		 * @return 1 when the animation is finished and the object must be destroyed.
 		 */
 		virtual int update();
+		
+		/** Save the animation progress in addition to parent class fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore the animation progress in addition to parent class fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	private:
 		/** Tell whether the animation finished playing. */
@@ -44,7 +44,7 @@ namespace AudioManager
 
 	/** Play the specified sound once.
 	* @param id Which sound to play.
-	* @note Do nothing if the provided ID is bad or if there is not enough resources to play a new sound.
+	* @note Do nothing if the provided ID is bad, if there is not enough resources to play a new sound or if the audio subsystem was not initialized (headless mode).
 	*/
 	void playSound(SoundId id);
 
@@ -0,0 +1,92 @@
+/** @file Benchmark.hpp
+ * Measure the game logic performance while running scenarios without display. The benchmark code is built only when CONFIGURATION_BUILD_FOR_BENCHMARK is defined (see "make bench"), so the game binary is not slowed down by the measurements.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_BENCHMARK_HPP
+#define HPP_BENCHMARK_HPP
+
+//-------------------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------------------
+/** @def BENCHMARK_BEGIN_PHASE() Stop measuring the current game logic phase and start measuring another one.
+ * @param phaseId The phase to measure, it is a Benchmark::PhaseId value without the namespace.
+ * @note The macro does nothing when the benchmark is not built.
+ */
+#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+	#define BENCHMARK_BEGIN_PHASE(phaseId) Benchmark::beginPhase(Benchmark::phaseId)
+#else
+	#define BENCHMARK_BEGIN_PHASE(phaseId) {} // Replace by an empty scope instead of nothing in case the macro is the only instruction of an if
+#endif
+
+#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+namespace Benchmark
+{
+	/** All measured parts of a game logic tick, in execution order. */
+	typedef enum
+	{
+		PHASE_ID_INPUTS, //!< Bot decision, player moves and shots.
+		PHASE_ID_PLAYER, //!< Player update (items pick up, level exit).
+		PHASE_ID_PLAYER_BULLETS, //!< Player bullets moves and collisions.
+		PHASE_ID_ENEMIES, //!< Pathfinding update, enemies artificial intelligence and shots.
+		PHASE_ID_ENEMIES_BULLETS, //!< Enemies bullets moves and collisions.
+		PHASE_ID_ENEMY_SPAWNERS, //!< Enemy spawners update and enemies spawning.
+		PHASE_ID_EFFECTS, //!< Effects animation and simulation clock update.
+		PHASE_IDS_COUNT
+	} PhaseId;
+
+	/** What a scenario file describes. */
+	typedef struct
+	{
+		int levelNumber; //!< The level the scenario is played on.
+		int enemiesCount; //!< How many enemies are spawned at random places when the scenario starts.
+		int smallEnemiesPercentage; //!< The percentage of small enemies among the spawned ones.
+		int mediumEnemiesPercentage; //!< The percentage of medium enemies among the spawned ones (the remaining enemies are big ones).
+		int bulletsPerSecond; //!< How many bullets are fired from random places every second of simulation time, half by the player and half by the enemies.
+		int ticksCount; //!< How many game logic ticks the scenario lasts.
+		unsigned int randomSeed; //!< The random numbers streams seed.
+		bool isBotEnabled; //!< Set to true to make the bot play during the scenario, otherwise the player does not move.
+	} Scenario;
+
+	/** Load a scenario file. It contains "name value" lines (name can be level, enemies, small_enemies_percentage, medium_enemies_percentage, bullets_per_second, ticks, seed or bot), lines starting with '#' are comments. Missing values keep their default.
+	 * @param pointerStringFileName The scenario file.
+	 * @param pointerScenario On output, contain the scenario.
+	 * @return 0 if the scenario was successfully loaded,
+	 * @return -1 if the file could not be opened or if it is malformed.
+	 */
+	int loadScenario(const char *pointerStringFileName, Scenario *pointerScenario);
+
+	/** Reset all measurements before a scenario is run. */
+	void beginScenario();
+
+	/** Start measuring a game logic tick, beginning with the PHASE_ID_INPUTS phase. */
+	void beginTick();
+
+	/** Stop measuring the current phase and start measuring another one.
+	 * @param phaseId The new phase.
+	 */
+	void beginPhase(PhaseId phaseId);
+
+	/** Stop measuring the current game logic tick.
+	 * @param enemiesCount How many enemies are alive at the tick end.
+	 * @param enemySpawnersCount How many enemy spawners are alive at the tick end.
+	 * @param playerBulletsCount How many player bullets are alive at the tick end.
+	 * @param enemiesBulletsCount How many enemies bullets are alive at the tick end.
+	 */
+	void endTick(int enemiesCount, int enemySpawnersCount, int playerBulletsCount, int enemiesBulletsCount);
+
+	/** Store the measurements of the scenario that just ended, they will be written by writeResults().
+	 * @param pointerStringFileName The scenario file, used to name the scenario.
+	 * @param pointerScenario The scenario parameters.
+	 */
+	void endScenario(const char *pointerStringFileName, Scenario *pointerScenario);
+
+	/** Write all scenarios measurements to a JSON file.
+	 * @param pointerStringFileName The file to create.
+	 * @return 0 if the file was successfully written,
+	 * @return -1 if an error occurred.
+	 */
+	int writeResults(const char *pointerStringFileName);
+}
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+/** @file BotManager.hpp
+ * A scripted player that plays the game without anybody at the keyboard. It routes to the nearest enemy spawner over the level blocks, shoots the enemies and the spawners located on the same row or column, and picks up medipacks and ammunition when needed. The bot presses the same keys than a human player, so its games can be recorded and replayed.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_BOT_MANAGER_HPP
+#define HPP_BOT_MANAGER_HPP
+
+#include <EnemyFightingEntity.hpp>
+#include <list>
+#include <Snapshot.hpp>
+
+namespace BotManager
+{
+	/** Choose the keys to press for the next game logic tick. Each thread has its own bot, playing the thread world.
+	* @param pointerEnemiesList All living enemies.
+	* @return A bit field formatted like ControlManager::getGameplayKeysState() result.
+	*/
+	unsigned int computeGameplayKeysState(std::list<EnemyFightingEntity *> *pointerEnemiesList);
+
+	/** Append the bot route state to a snapshot, so a restored game makes the same decisions.
+	* @param pointerSnapshot The snapshot to write to.
+	*/
+	void saveState(Snapshot *pointerSnapshot);
+
+	/** Restore the bot route state stored by saveState().
+	* @param pointerSnapshot The snapshot to read from.
+	*/
+	void restoreState(Snapshot *pointerSnapshot);
+}
+
+#endif
@@ -31,14 +31,69 @@ class BulletMovingEntity: public MovingEntity
 		 */
 		int getDamageAmount();
 		
-		/** Check if a scene wall has been hit.
+		/** Make the bullet damage all enemies and enemy spawners around the location it explodes at, in addition to the entity it hits.
+		 * @param radius The distance in pixels around the explosion where entities are damaged.
+		 * @param damageAmount How many life points the explosion removes.
+		 */
+		void enableSplashDamage(int radius, int damageAmount);
+		
+		/** Get the distance around the bullet explosion where entities are damaged.
+		 * @return 0 if the bullet does not explode,
+		 * @return the explosion radius in pixels.
+		 */
+		inline int getSplashRadius()
+		{
+			return _splashRadius;
+		}
+		
+		/** How many life points the bullet explosion removes.
+		 * @return Life points to ADD to the entities around the explosion (the value is negative yet to directly use with modifyLife() functions).
+		 */
+		inline int getSplashDamageAmount()
+		{
+			return _splashDamageAmount;
+		}
+		
+		/** Make the bullet turn toward the closest enemy or enemy spawner. */
+		void enableHoming();
+		
+		/** Get the texture the bullet was created with.
+		 * @return The bullet "facing up" texture.
+		 */
+		inline TextureManager::TextureId getTextureId()
+		{
+			return _textureId;
+		}
+		
+		/** Get the area the bullet went through during the last update() call, from its previous position to its current one. Testing the entities against this area instead of the bullet position rectangle avoids bullets crossing small entities without hitting them when they move more pixels per tick than the entities size.
+		 * @return The swept area rectangle.
+		 */
+		inline SDL_Rect *getSweptRectangle()
+		{
+			return &_sweptRectangle;
+		}
+		
+		/** Turn toward the closest target if the bullet is homing, then check if a scene wall has been hit.
 		 * @return 0 if nothing was hit,
 		 * @return 1 if scene wall was hit and the bullet must be destroyed.
-		 * @warning This function does not check against enemy or player collision.
+		 * @warning This function does not check against enemy or player collision, use getSweptRectangle() to do so even when the bullet must be destroyed.
 		 */
 		virtual int update();
+		
+		/** Save the traveled distance, the damage, the splash damage and the homing state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore the traveled distance, the damage, the splash damage and the homing state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	private:
+		/** The "facing up" texture, which is needed to create the same bullet again when restoring a snapshot. */
+		TextureManager::TextureId _textureId;
+		
 		/** A bullet maximum traveling distance, the bullet will be destroyed if it has traveled this distance without colliding with something. */
 		int _range;
 		/** How many distance was traveled. */
@@ -46,6 +101,17 @@ class BulletMovingEntity: public MovingEntity
 		
 		/** How many life points the bullet removes when it hits an entity. */
 		int _damageAmount;
+		
+		/** The distance around the bullet explosion where entities are damaged, or 0 if the bullet does not explode. */
+		int _splashRadius;
+		/** How many life points the explosion removes (the value is negative like _damageAmount). */
+		int _splashDamageAmount;
+		
+		/** Tell whether the bullet follows the closest target. */
+		bool _isHoming;
+		
+		/** The area the bullet went through during the last update. */
+		SDL_Rect _sweptRectangle;
 };
 
 #endif
@@ -0,0 +1,74 @@
+/** @file CollisionManager.hpp
+ * Find which entities the projectiles hit. Each entity belongs to a collision layer, and a collision matrix tells which layers the projectiles of a layer can hit, so all projectiles kinds are checked by the same pass.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_COLLISION_MANAGER_HPP
+#define HPP_COLLISION_MANAGER_HPP
+
+#include <EnemyFightingEntity.hpp>
+#include <Entity.hpp>
+#include <RectanglesBatch.hpp>
+#include <vector>
+
+/** @def COLLISION_MANAGER_LAYER_BIT(layer) Convert a layer to its bit in a layers mask.
+ * @param layer The layer, it is a CollisionManager::Layer value.
+ */
+#define COLLISION_MANAGER_LAYER_BIT(layer) (1 << (layer))
+
+namespace CollisionManager
+{
+	/** All collision layers. When a projectile overlaps entities of several layers at once, it hits the layer coming first in this list. */
+	typedef enum
+	{
+		LAYER_PLAYER_PROJECTILE,
+		LAYER_ENEMY_PROJECTILE,
+		LAYER_ENEMY,
+		LAYER_ENEMY_SPAWNER,
+		LAYER_PLAYER,
+		LAYERS_COUNT
+	} Layer;
+
+	/** A projectile hit an entity. */
+	typedef struct
+	{
+		int projectileIndex; //!< The projectile rectangle index in the batch given to findContacts().
+		Layer layer; //!< The hit entity layer, telling the hit entity class.
+		Entity *pointerEntity; //!< The hit entity.
+	} Contact;
+
+	/** An entity found by a spatial query. */
+	typedef struct
+	{
+		Layer layer; //!< The entity layer, telling the entity class.
+		Entity *pointerEntity; //!< The found entity.
+		int squaredDistance; //!< The squared distance in pixels between the query point and the closest point of the entity position rectangle.
+	} QueryResult;
+
+	/** Find the entities hit by some projectiles. A projectile hits at most one entity. When a projectile hits several enemies at once, the one coming first in the enemies list (the one with the smallest update order) is hit.
+	* @param projectilesLayer The layer all the projectiles belong to.
+	* @param pointerProjectilesRectangles The areas the projectiles went through during the tick.
+	* @param pointerContacts On output, contain the contacts sorted by projectile index. The vector is cleared before the contacts are added.
+	*/
+	void findContacts(Layer projectilesLayer, RectanglesBatch *pointerProjectilesRectangles, std::vector<Contact> *pointerContacts);
+
+	/** Find all entities located in a circle. Only the level blocks the circle overlaps are looked at, so the query cost does not depend on the living entities count.
+	* @param x The circle center X coordinate in pixels.
+	* @param y The circle center Y coordinate in pixels.
+	* @param radius The circle radius in pixels.
+	* @param layersMask The layers to look for entities in, made of ORed COLLISION_MANAGER_LAYER_BIT() values. Only enemies, enemy spawners and the player can be found.
+	* @param pointerResults On output, contain the entities overlapping the circle in no particular order. The vector is cleared before the entities are added.
+	*/
+	void queryRadius(int x, int y, int radius, unsigned int layersMask, std::vector<QueryResult> *pointerResults);
+
+	/** Find the entities closest to a point.
+	* @param x The point X coordinate in pixels.
+	* @param y The point Y coordinate in pixels.
+	* @param maximumDistance Entities further than this distance in pixels are ignored, which bounds the searched level area.
+	* @param layersMask The layers to look for entities in, made of ORed COLLISION_MANAGER_LAYER_BIT() values. Only enemies, enemy spawners and the player can be found.
+	* @param count How many entities to find at most.
+	* @param pointerResults On output, contain the found entities, the closest one first. The vector is cleared before the entities are added.
+	*/
+	void queryNearest(int x, int y, int maximumDistance, unsigned int layersMask, int count, std::vector<QueryResult> *pointerResults);
+}
+
+#endif
@@ -19,8 +19,6 @@
 #define CONFIGURATION_DISPLAY_WIDTH 1024
 /** Display height in pixels (only in windowed mode). */
 #define CONFIGURATION_DISPLAY_HEIGHT 768
-/** Display refresh period (for a 60Hz refresh frequency, the period is 1/60 = 0.016ms). */
-#define CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS 16
 /** HUD background texture screen X coordinate. */
 #define CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X 10
 /** HUD background texture screen Y coordinate. */
@@ -44,6 +42,16 @@
 /** Bonus timer text screen Y coordinate. */
 #define CONFIGURATION_DISPLAY_HUD_BONUS_TIMER_Y 20
 
+// Game logic
+/** Game logic is updated at this fixed period, whatever the display refresh rate is (16ms is about 60 ticks per second). */
+#define CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS 16
+/** Maximum amount of game logic ticks executed before rendering a frame. When the game is too slow to catch up, it slows down instead of never rendering anything. */
+#define CONFIGURATION_GAME_LOGIC_MAXIMUM_TICKS_PER_FRAME 5
+/** The slowest game clock time scale (simulation time runs 4 times slower than real time). */
+#define CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE 0.25f
+/** The fastest game clock time scale (simulation time runs 50 times faster than real time). */
+#define CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE 50.0f
+
 // Menu
 /** Maximum amount of items that a single menu can display. */
 #define CONFIGURATION_MENU_MAXIMUM_ITEMS_COUNT 5
@@ -88,6 +96,8 @@
 #define CONFIGURATION_GAMEPLAY_MACHINE_GUN_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE 8
 /** The probability (in range 0% to 100%) to spawn bulletproof vest bonus when an enemy dies. */
 #define CONFIGURATION_GAMEPLAY_BULLETPROOF_VEST_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE 6
+/** The probability (in range 0% to 100%) to spawn homing rockets when an enemy dies. */
+#define CONFIGURATION_GAMEPLAY_HOMING_ROCKETS_ITEM_SPAWN_PROBABILITY_PERCENTAGE 8
 // The probability (in range 0% to 100%) to spawn a specific enemy (sum of all enemies percentages must be 100 and each percentage must be less than the previous one)
 /** Small enemy spawning probability. */
 #define CONFIGURATION_GAMEPLAY_SMALL_ENEMY_SPAWN_PROBABILITY_PERCENTAGE 80
@@ -103,14 +113,52 @@
 #define CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS 300
 /** Player secondary fire needed ammunition amount for shooting. */
 #define CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT 100
+/** The distance in pixels around a mortar shell explosion where enemies and enemy spawners are damaged. */
+#define CONFIGURATION_GAMEPLAY_MORTAR_SHELL_SPLASH_RADIUS (3 * CONFIGURATION_LEVEL_BLOCK_SIZE / 2)
+/** How many life points a mortar shell explosion removes to the enemies and enemy spawners around it (the directly hit entity only receives the shell damage). */
+#define CONFIGURATION_GAMEPLAY_MORTAR_SHELL_SPLASH_DAMAGE_AMOUNT 10
+/** How many homing rockets a homing rockets item gives. The next mortar shells are replaced by rockets until they are all shot. */
+#define CONFIGURATION_GAMEPLAY_HOMING_ROCKETS_ITEM_ROCKETS_AMOUNT 3
+/** The distance in pixels a homing rocket looks for an enemy or an enemy spawner to follow. */
+#define CONFIGURATION_GAMEPLAY_HOMING_ROCKET_DETECTION_RADIUS (6 * CONFIGURATION_LEVEL_BLOCK_SIZE)
 /** How many time a spawner waits before spawning a new enemy (in millisecond). */
 #define CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN 3000
 /** Joystick analog parts threshold to consider the part is pushed (must be in range [0..32767] according to SDL documentation). */
 #define CONFIGURATION_GAMEPLAY_JOYSTICK_ANALOG_THRESHOLD 25000
 
+// Headless mode
+/** How many game logic updates are simulated in headless mode when no amount is provided on the command line. */
+#define CONFIGURATION_HEADLESS_DEFAULT_TICKS_COUNT 10000
+
+// Benchmark
+/** The file the benchmark results are written to when no file is provided on the command line. */
+#define CONFIGURATION_BENCHMARK_DEFAULT_RESULTS_FILE_NAME "Benchmark_Results.json"
+/** The player life points during a benchmark scenario. They are restored before each tick, so the player survives the scenario whatever the enemies and bullets amounts are. */
+#define CONFIGURATION_BENCHMARK_PLAYER_LIFE_POINTS_AMOUNT 1000000
+
+// Bot
+/** How many game logic ticks the bot follows a route before computing it again, even if the player did not reach a new block. */
+#define CONFIGURATION_BOT_ROUTE_REFRESHING_PERIOD 60
+/** The bot does not shoot targets that are further than this distance (in pixels). */
+#define CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE (8 * CONFIGURATION_LEVEL_BLOCK_SIZE)
+/** The bot looks for medipacks when the player life points fall below this percentage of the player maximum life points. */
+#define CONFIGURATION_BOT_MEDIPACK_LIFE_POINTS_PERCENTAGE 60
+/** How far (in pixels) the player can be from a block center to be considered at the center. It must be greater than or equal to the player moving speed, so the bot does not oscillate around the center. */
+#define CONFIGURATION_BOT_POSITION_TOLERANCE 3
+
 // Savegame
 /** The savegame file. */
 #define CONFIGURATION_SAVEGAME_FILE_NAME "Savegame.txt"
+/** The file storing the whole world when the player saves a checkpoint. */
+#define CONFIGURATION_CHECKPOINT_FILE_NAME "Checkpoint.bin"
+
+// Pathfinding
+/** The flow field toward the player covers only the blocks located at most this path distance (in blocks) from the player block. Enemies move only when they spot the player, so they never need a longer path, and the flow field cost does not depend on the level size. */
+#define CONFIGURATION_PATHFINDING_FLOW_FIELD_MAXIMUM_DISTANCE 64
+/** The level is split in square clusters of this size (in blocks) to find long paths on a graph of the cluster borders crossings instead of on all blocks. */
+#define CONFIGURATION_PATHFINDING_CLUSTER_SIZE 16
+/** How many paths are remembered, it must be a power of two. */
+#define CONFIGURATION_PATHFINDING_PATHS_CACHE_SIZE 256
 
 // Player entity
 /** The offset to add to player left side when spawning the "mortar shell muzzle flash" effect while the player is facing up. */
@@ -54,6 +54,16 @@ namespace ControlManager
 	* @return false if the direction was horizontal.
 	*/
 	bool isLastPressedDirectionKeyOnVerticalAxis();
+
+	/** Get the state of all keys that control the player in game (directions and shoots, but not pause or menu keys) at once.
+	* @return A bit field where bit n is set when the key with ID n is pressed. Bit KEY_ID_PAUSE_GAME tells whether the last pressed direction key was on the vertical axis.
+	*/
+	unsigned int getGameplayKeysState();
+
+	/** Overwrite the state of all keys that control the player in game (for instance to replay a recorded game).
+	* @param keysState A bit field formatted like getGameplayKeysState() result.
+	*/
+	void setGameplayKeysState(unsigned int keysState);
 }
 
 #endif
@@ -5,6 +5,8 @@
 #ifndef HPP_EFFECT_MANAGER_HPP
 #define HPP_EFFECT_MANAGER_HPP
 
+#include <Snapshot.hpp>
+
 namespace EffectManager
 {
 	/** All available effects. */
@@ -75,6 +77,18 @@ namespace EffectManager
 	* @note Must be called on the game rendering step.
 	*/
 	void render();
+
+	/** Append all currently playing effects to a snapshot.
+	* @param pointerSnapshot The snapshot to write to.
+	*/
+	void saveState(Snapshot *pointerSnapshot);
+
+	/** Replace all currently playing effects by the ones stored in a snapshot (effects sounds are not played again).
+	* @param pointerSnapshot The snapshot to read from.
+	* @return 0 if the effects were restored,
+	* @return -1 if the snapshot is corrupted.
+	*/
+	int restoreState(Snapshot *pointerSnapshot);
 }
 
 #endif
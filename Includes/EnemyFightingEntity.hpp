@@ -6,6 +6,7 @@
 
 #include <EffectManager.hpp>
 #include <FightingEntity.hpp>
+#include <RectanglesBatch.hpp>
 #include <SDL2/SDL.h>
 
 /** @class EnemyFightingEntity
@@ -14,6 +15,15 @@
 class EnemyFightingEntity: public FightingEntity
 {
 	public:
+		/** All enemy kinds. */
+		typedef enum
+		{
+			ENEMY_TYPE_SMALL,
+			ENEMY_TYPE_MEDIUM,
+			ENEMY_TYPE_BIG,
+			ENEMY_TYPES_COUNT
+		} EnemyType;
+		
 		/** Spawn a new enemy.
 		 * @param x The X coordinate where to spawn the entity.
 		 * @param y The Y coordinate where to spawn the entity.
@@ -57,13 +67,44 @@ class EnemyFightingEntity: public FightingEntity
 		
 		// No need for documentation because it is the same as parent function
 		virtual void render();
+		
+		/** Tell which kind of enemy this is, so the right class can be instantiated when the enemy is restored from a snapshot.
+		 * @return The enemy type.
+		 */
+		virtual EnemyType getType() = 0;
+		
+		/** Tell when the enemy is updated relatively to the other enemies.
+		 * @return The update order, enemies with a smaller order are updated first.
+		 */
+		inline int getUpdateOrder()
+		{
+			return _updateOrder;
+		}
+		
+		/** Set when the enemy is updated relatively to the other enemies. The enemies list order is kept this way when only the enemies close to the player are updated.
+		 * @param updateOrder The update order, enemies with a smaller order are updated first.
+		 */
+		inline void setUpdateOrder(int updateOrder)
+		{
+			_updateOrder = updateOrder;
+		}
+		
+		/** Save the artificial intelligence state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore the artificial intelligence state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	protected:
-		/** The player will be spotted by the enemy if he enters this area. */
-		SDL_Rect _spottingRectangle;
+		/** Where the spotting rectangle is stored in the sight rectangles batch. */
+		static const int SPOTTING_RECTANGLE_INDEX = DIRECTIONS_COUNT;
 		
-		/** The enemy will shoot if the player enters one of these rectangles. */
-		SDL_Rect _shootingRectangles[DIRECTIONS_COUNT];
+		/** The rectangles the player is tested against each tick, so all of them are tested at once. The enemy will shoot if the player enters one of the shooting rectangles, which are stored at their direction index. The player will be spotted by the enemy if he enters the spotting rectangle, stored at SPOTTING_RECTANGLE_INDEX. */
+		RectanglesBatch _sightRectangles;
 		
 		/** Tell if a replacement direction has been chosen or not. */
 		int _isReplacementDirectionChosen;
@@ -74,11 +115,37 @@ class EnemyFightingEntity: public FightingEntity
 		EffectManager::EffectId _explosionEffectId;
 
 	private:
+		/** The area the enemy is registered with in the level blocks enemies index. It covers all facing directions textures, so the enemy does not need to be registered again when it turns. */
+		SDL_Rect _indexedRectangle;
+		
+		/** Tell whether the enemy is counted in a block enemies count. */
+		bool _isCountedInBlock;
+		/** The X coordinate in pixels of the point the enemy was counted at, so it is removed from the same block even if it was moved in the meantime. */
+		int _countedX;
+		/** The Y coordinate in pixels of the point the enemy was counted at. */
+		int _countedY;
+		
+		/** The first level block column crossed by the up and down shooting rectangles. The player can be shot only when he stands on one of the block columns or rows the shooting rectangles cross. */
+		int _shootingLaneFirstColumn;
+		/** The last level block column crossed by the up and down shooting rectangles. */
+		int _shootingLaneLastColumn;
+		/** The first level block row crossed by the left and right shooting rectangles. */
+		int _shootingLaneFirstRow;
+		/** The last level block row crossed by the left and right shooting rectangles. */
+		int _shootingLaneLastRow;
+		
+		/** The pathfinding regions version the enemy found the player unreachable with, or 0. The enemy stays idle until the regions change. */
+		unsigned int _idleRegionsVersion;
+		
+		/** When the enemy is updated relatively to the other enemies. */
+		int _updateOrder;
+		
 		/** Tell if the enemy can shoot the player or not.
+		 * @param sightRectanglesMask The sight rectangles the player intersects with, as returned by RectanglesBatch::computeIntersectionsMask().
 		 * @return 1 if the enemy can shoot,
 		 * @return 0 if the player is out of range.
 		 */
-		int _isShootPossible();
+		int _isShootPossible(unsigned int sightRectanglesMask);
 		
 		/** Tell in which direction to go to reach the player.
 		 * @param pointerDirection On output, contain the player direction.
@@ -87,10 +154,23 @@ class EnemyFightingEntity: public FightingEntity
 		 */
 		int _getPlayerDirection(Direction *pointerDirection);
 		
-		/** Set or reset a block flag telling whether an enemy is present on the block.
-		 * @param isEnemyPresent Set to true to set the flag, set to false to reset the flag.
+		/** Tell in which direction to go to follow the shortest path to the player block, which goes around the walls.
+		 * @param pointerDirection On output, contain the path direction.
+		 * @return 1 if the enemy must follow the path,
+		 * @return 0 if the enemy is on the player block or if it can't reach the player.
+		 */
+		int _getPathDirection(Direction *pointerDirection);
+		
+		/** Remove the enemy from the block enemies count it was counted in, then count it in the block under its center if requested.
+		 * @param isEnemyPresent Set to true to count the enemy in the block under its center, set to false to only remove it from its current block.
 		 */
 		void _setBlockEnemyContent(bool isEnemyPresent);
+		
+		/** Register the enemy again in the level blocks enemies index if it moved to other blocks. */
+		void _updateBlocksIndex();
+		
+		/** Compute again the level block rows and columns the shooting rectangles cross, after they have been moved. */
+		void _updateShootingLanes();
 };
 
 #endif
@@ -33,6 +33,14 @@ class EnemySpawnerStaticEntity: public StaticEntity
 			if (_lifePointsAmount < 0) _lifePointsAmount = 0;
 		}
 		
+		/** Get the entity life points amount.
+		 * @return The entity life points.
+		 */
+		inline int getLifePointsAmount()
+		{
+			return _lifePointsAmount;
+		}
+		
 		// No need for documentation because it is the same as parent function
 		virtual void render();
 		
@@ -41,6 +49,16 @@ class EnemySpawnerStaticEntity: public StaticEntity
 		 * @return 1 if the spawner is destroyed and must be removed.
 		 */
 		virtual int update();
+		
+		/** Save life points and teleportation animation progress in addition to parent class fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore life points (showing the corresponding damage state) and teleportation animation progress in addition to parent class fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	private:
 		/** How many life points the entity owns. */
@@ -5,6 +5,7 @@
 #define HPP_ENTITY_HPP
 
 #include <SDL2/SDL.h>
+#include <Snapshot.hpp>
 
 /** @class Entity
  * Base class for all game entities.
@@ -45,6 +46,16 @@ class Entity
 		 * @return The position rectangle.
 		 */
 		virtual SDL_Rect *getPositionRectangle() = 0;
+		
+		/** Append everything needed to restore the entity later to a snapshot.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot) = 0;
+		
+		/** Restore the entity state written by saveState(). The entity must have been created with the same parameters than the saved one.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot) = 0;
 };
 
 #endif
@@ -95,6 +95,16 @@ class FightingEntity: public MovingEntity
 		 * @return NULL if the entity could not shoot (no more ammunition, slower fire rate...).
 		 */
 		virtual BulletMovingEntity *shoot();
+		
+		/** Save life points and fire rate state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore life points and fire rate state in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	protected:
 		/** How many life points the entity owns. */
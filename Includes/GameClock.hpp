@@ -0,0 +1,60 @@
+/** @file GameClock.hpp
+ * Provide the simulation time used by all game logic timers. Simulation time advances by a fixed amount on each game logic tick, so game outcomes do not depend on the real time elapsed between ticks. Each thread has its own clock, so simulations can run in parallel.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_GAME_CLOCK_HPP
+#define HPP_GAME_CLOCK_HPP
+
+namespace GameClock
+{
+	/** Restart the simulation time from zero and synchronize the clock with the real time. */
+	void initialize();
+
+	/** Get the simulation time.
+	* @return The simulation time in milliseconds.
+	* @note Use unsigned subtraction to compute durations, it works even when the value wraps around.
+	*/
+	unsigned int getTime();
+
+	/** Jump to a simulation time, for instance when the world is restored from a snapshot.
+	* @param time The simulation time in milliseconds.
+	*/
+	void setTime(unsigned int time);
+
+	/** Advance the simulation time by one game logic tick period. Must be called once per game logic tick. */
+	void tick();
+
+	/** Compute how many game logic ticks must be executed to catch up with the real time elapsed since the last call, taking into account pause and time scaling.
+	* @return How many times the game logic must be updated before rendering the next frame (it is 0 when the clock is paused).
+	* @note The amount of ticks is bounded, so the game slows down instead of freezing if the computer can't keep up.
+	*/
+	int computeTicksToExecuteCount();
+
+	/** Tell how far the real time is between the last executed tick and the next one.
+	* @return A value in range [0; 1].
+	*/
+	float getTicksInterpolationFactor();
+
+	/** Stop or resume simulation time. The real time elapsed while the clock is paused is never caught up.
+	* @param isPaused Set to true to pause the clock, set to false to resume it.
+	*/
+	void setPaused(bool isPaused);
+
+	/** Tell whether the clock is paused.
+	* @return true if the clock is paused,
+	* @return false if simulation time is running.
+	*/
+	bool isPaused();
+
+	/** Set how fast simulation time runs compared to real time.
+	* @param timeScale The time scale, it is clamped to range [CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE; CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE]. Use 1 for real time.
+	*/
+	void setTimeScale(float timeScale);
+
+	/** Get how fast simulation time runs compared to real time.
+	* @return The time scale.
+	*/
+	float getTimeScale();
+}
+
+#endif
@@ -7,6 +7,11 @@
 
 #include <EnemySpawnerStaticEntity.hpp>
 #include <list>
+#include <Snapshot.hpp>
+#include <vector>
+
+// Forward declaration to avoid an include loop, enemies need the level manager to move
+class EnemyFightingEntity;
 
 namespace LevelManager
 {
@@ -19,13 +24,14 @@ namespace LevelManager
 		BLOCK_CONTENT_AMMUNITION = 1 << 3, //!< If set, tell that ammunition are present on top of this block.
 		BLOCK_CONTENT_MACHINE_GUN_BONUS = 1 << 4, //!< If set, tell that a machine gun bonus is present on top of this block.
 		BLOCK_CONTENT_BULLETPROOF_VEST_BONUS = 1 << 5, //!< If set, tell that a bulletproof vest bonus is present on top of this block.
-		BLOCK_CONTENT_ENEMY = 1 << 6, //!< If set, tell that an enemy is walking on this block, so no other enemy can go through this block to avoid collisions.
+		BLOCK_CONTENT_ENEMY = 1 << 6, //!< If set, tell that at least one enemy is walking on this block, so no other enemy can go through this block to avoid collisions. It is managed by increaseBlockEnemiesCount() and decreaseBlockEnemiesCount().
 		BLOCK_CONTENT_ENEMY_SPAWNER = 1 << 7, //!< If set, tell that the whole block is occupied by an enemy spawner. Player and enemies can't cross the block, but bullets can.
-		BLOCK_CONTENT_LEVEL_EXIT = 1 << 8 //!< If set and the player walks on it, the game will load the next level.
+		BLOCK_CONTENT_LEVEL_EXIT = 1 << 8, //!< If set and the player walks on it, the game will load the next level.
+		BLOCK_CONTENT_HOMING_ROCKETS = 1 << 9 //!< If set, tell that homing rockets are present on top of this block.
 	} BlockContent;
 
-	/** Contain all living enemy spawners. */
-	extern std::list<EnemySpawnerStaticEntity *> enemySpawnersList;
+	/** Contain all living enemy spawners of the calling thread world. */
+	extern thread_local std::list<EnemySpawnerStaticEntity *> &enemySpawnersList;
 
 	/** Prepare all scene blocks.
 	 * @return -1 if an error occurred,
@@ -36,13 +42,40 @@ namespace LevelManager
 	/** Free all allocated resources. */
 	void uninitialize();
 
-	/** Load a level from two Comma Separated Value files (x_Scene.csv and x_Objects.csv, where x is the level number).
+	/** Load a level from two Comma Separated Value files (x_Scene.csv and x_Objects.csv, where x is the level number). Each level is parsed once and shared by all threads, so loading it again (when the level is restarted or by another simulation session) does not access the files.
 	 * @param levelNumber The level number (starting from 0).
 	 * @return -1 if an error occurred,
 	 * @return 0 if the level was successfully loaded.
 	 */
 	int loadLevel(int levelNumber);
 
+	/** Tell which level is loaded.
+	 * @return The loaded level number, or -1 if no level is loaded.
+	 */
+	int getLoadedLevelNumber();
+
+	/** Get the loaded level width.
+	 * @return The level width in blocks.
+	 */
+	int getLevelWidthBlocks();
+
+	/** Get the loaded level height.
+	 * @return The level height in blocks.
+	 */
+	int getLevelHeightBlocks();
+
+	/** Append all blocks content and all enemy spawners to a snapshot.
+	 * @param pointerSnapshot The snapshot to write to.
+	 */
+	void saveState(Snapshot *pointerSnapshot);
+
+	/** Restore all blocks content and all enemy spawners. The level the snapshot was taken from must be loaded.
+	 * @param pointerSnapshot The snapshot to read from.
+	 * @return 0 if the level state was restored,
+	 * @return -1 if the snapshot does not match the loaded level or if it is corrupted.
+	 */
+	int restoreState(Snapshot *pointerSnapshot);
+
 	/** Display the scene (decor) to the main renderer.
 	 * @param topLeftX This is the scene horizontal coordinate to start drawing from.
 	 * @param topLeftY This is the scene vertical coordinate to start drawing from.
@@ -53,7 +86,7 @@ namespace LevelManager
 	 * @param x Point x coordinate in pixels.
 	 * @param y Point y coordinate in pixels.
 	 * @param blockContent The type of block to check (wall, enemy spawner...). Block types can be ORed to check multiple blocks at a time.
-	 * @return The distance in pixels. To be faster, the functions stops if the first searched block is further than CONFIGURATION_LEVEL_BLOCK_SIZE pixels.
+	 * @return The distance in pixels. Walls and enemy spawners are found at any distance, enemies are looked for on the next block only (so the distance is at most CONFIGURATION_LEVEL_BLOCK_SIZE pixels beyond the current block when enemies are checked).
 	 */
 	int getDistanceFromUpperBlock(int x, int y, int blockContent);
 
@@ -61,7 +94,7 @@ namespace LevelManager
 	 * @param x Point x coordinate in pixels.
 	 * @param y Point y coordinate in pixels.
 	 * @param blockContent The type of block to check (wall, enemy spawner...). Block types can be ORed to check multiple blocks at a time.
-	 * @return The distance in pixels. To be faster, the functions stops if the first searched block is further than CONFIGURATION_LEVEL_BLOCK_SIZE pixels.
+	 * @return The distance in pixels. Walls and enemy spawners are found at any distance, enemies are looked for on the next block only (so the distance is at most CONFIGURATION_LEVEL_BLOCK_SIZE pixels beyond the current block when enemies are checked).
 	 */
 	int getDistanceFromDownerBlock(int x, int y, int blockContent);
 
@@ -69,7 +102,7 @@ namespace LevelManager
 	 * @param x Point x coordinate in pixels.
 	 * @param y Point y coordinate in pixels.
 	 * @param blockContent The type of block to check (wall, enemy spawner...). Block types can be ORed to check multiple blocks at a time.
-	 * @return The distance in pixels. To be faster, the functions stops if the first searched block is further than CONFIGURATION_LEVEL_BLOCK_SIZE pixels.
+	 * @return The distance in pixels. Walls and enemy spawners are found at any distance, enemies are looked for on the next block only (so the distance is at most CONFIGURATION_LEVEL_BLOCK_SIZE pixels beyond the current block when enemies are checked).
 	 */
 	int getDistanceFromLeftmostBlock(int x, int y, int blockContent);
 
@@ -77,7 +110,7 @@ namespace LevelManager
 	 * @param x Point x coordinate in pixels.
 	 * @param y Point y coordinate in pixels.
 	 * @param blockContent The type of block to check (wall, enemy spawner...). Block types can be ORed to check multiple blocks at a time.
-	 * @return The distance in pixels. To be faster, the functions stops if the first searched block is further than CONFIGURATION_LEVEL_BLOCK_SIZE pixels.
+	 * @return The distance in pixels. Walls and enemy spawners are found at any distance, enemies are looked for on the next block only (so the distance is at most CONFIGURATION_LEVEL_BLOCK_SIZE pixels beyond the current block when enemies are checked).
 	 */
 	int getDistanceFromRightmostBlock(int x, int y, int blockContent);
 
@@ -99,6 +132,21 @@ namespace LevelManager
 	 */
 	bool isObstaclePresentOnHorizontalAxis(int leftmostX, int rightmostX, int y);
 
+	/** Tell if a block can't be crossed by the player nor the enemies, because it is a wall or an enemy spawner.
+	 * @param xBlock The block X coordinate (in blocks).
+	 * @param yBlock The block Y coordinate (in blocks).
+	 * @return false if the block can be crossed,
+	 * @return true if the block is an obstacle or is outside of the level.
+	 */
+	bool isObstacleBlock(int xBlock, int yBlock);
+
+	/** Retrieve the level walls and enemy spawners changes, so data computed from the obstacles can be repaired instead of being computed again. Each call returns the changes that occurred since the previous call.
+	 * @param pointerChangedBlocksIndexes On output, contain the indexes (a level row after another) of the blocks that became obstacles or stopped being obstacles. The vector is cleared before the blocks are added.
+	 * @return 1 if a level was loaded or restored in the meantime, so all blocks must be considered changed,
+	 * @return 0 if only the returned blocks changed.
+	 */
+	int getObstaclesChanges(std::vector<int> *pointerChangedBlocksIndexes);
+
 	/** Get a block content.
 	 * @param x X coordinate in pixels.
 	 * @param y Y coordinate in pixels.
@@ -118,6 +166,60 @@ namespace LevelManager
 	 * @param y Y coordinate in pixels.
 	 */
 	void spawnItem(int x, int y);
+
+	/** Tell that one more enemy stands on a block, so other enemies can't walk through it.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void increaseBlockEnemiesCount(int x, int y);
+
+	/** Tell that an enemy left a block. The block can be crossed again when no enemy stands on it anymore.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void decreaseBlockEnemiesCount(int x, int y);
+
+	/** Register an enemy in all blocks overlapped by a rectangle, so collision tests can retrieve it without checking all enemies.
+	 * @param pointerEnemy The enemy to register.
+	 * @param pointerRectangle The area covered by the enemy, in pixels.
+	 */
+	void addEnemyToBlocks(EnemyFightingEntity *pointerEnemy, SDL_Rect *pointerRectangle);
+
+	/** Unregister an enemy from all blocks overlapped by a rectangle.
+	 * @param pointerEnemy The enemy to unregister.
+	 * @param pointerRectangle The rectangle the enemy was registered with.
+	 */
+	void removeEnemyFromBlocks(EnemyFightingEntity *pointerEnemy, SDL_Rect *pointerRectangle);
+
+	/** Find the enemies colliding with a rectangle, looking only at the enemies registered in the blocks the rectangle overlaps.
+	 * @param pointerRectangle The rectangle to test, in pixels.
+	 * @param pointerEnemies On output, the colliding enemies are appended to this vector (each enemy is appended once, in no particular order).
+	 */
+	void getEnemiesCollidingWithRectangle(SDL_Rect *pointerRectangle, std::vector<EnemyFightingEntity *> *pointerEnemies);
+
+	/** Find the enemies registered in the blocks a rectangle overlaps, without testing their position, which is faster for large areas.
+	 * @param pointerRectangle The area to look at, in pixels.
+	 * @param pointerEnemies On output, the enemies are appended to this vector (an enemy registered in several of the blocks is appended several times, in no particular order).
+	 */
+	void getEnemiesInBlocks(SDL_Rect *pointerRectangle, std::vector<EnemyFightingEntity *> *pointerEnemies);
+
+	/** Find the enemy spawner colliding with a rectangle by looking up the blocks the rectangle overlaps.
+	 * @param pointerRectangle The rectangle to test, in pixels.
+	 * @return NULL if no enemy spawner collides with the rectangle,
+	 * @return The colliding enemy spawner (the first one of enemySpawnersList if the rectangle collides with several spawners).
+	 */
+	EnemySpawnerStaticEntity *getEnemySpawnerCollidingWithRectangle(SDL_Rect *pointerRectangle);
+
+	/** Find all enemy spawners colliding with a rectangle by looking up the blocks the rectangle overlaps.
+	 * @param pointerRectangle The rectangle to test, in pixels.
+	 * @param pointerEnemySpawners On output, the colliding enemy spawners are appended to this vector (in the blocks order, row after row).
+	 */
+	void getEnemySpawnersCollidingWithRectangle(SDL_Rect *pointerRectangle, std::vector<EnemySpawnerStaticEntity *> *pointerEnemySpawners);
+
+	/** Remove a destroyed enemy spawner from the block it was standing on, so entities can cross the block again. The spawner must still be deleted and removed from enemySpawnersList by the caller.
+	 * @param pointerEnemySpawner The destroyed enemy spawner.
+	 */
+	void removeEnemySpawnerFromBlock(EnemySpawnerStaticEntity *pointerEnemySpawner);
 }
 
 #endif
@@ -21,8 +21,16 @@ class MediumEnemyFightingEntity: public EnemyFightingEntity
 		/** Free allocated resources. */
 		virtual ~MediumEnemyFightingEntity();
 		
+		// No need for documentation because it is the same as parent function
+		virtual EnemyType getType();
+		
 		// No need for documentation because it is the same as parent function
 		virtual int update();
+		
+		/** Restore the enemy state and show the corresponding damage state.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	protected:
 		// No need for documentation because it is the same as parent function
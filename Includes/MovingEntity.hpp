@@ -98,9 +98,34 @@ class MovingEntity: public Entity
 		/** Turn the entity to the right direction. */
 		void turnToRight();
 		
+		/** Remember the current position as the position the entity had before the next game logic tick. This allows rendering to interpolate the entity position between two ticks.
+		 * @note This function must be called before each game logic tick.
+		 */
+		void savePreviousPosition();
+		
+		/** Get the X coordinate the entity must be rendered at, interpolated between the two last game logic ticks.
+		 * @return The rendering X coordinate.
+		 */
+		int getInterpolatedX();
+		
+		/** Get the Y coordinate the entity must be rendered at, interpolated between the two last game logic ticks.
+		 * @return The rendering Y coordinate.
+		 */
+		int getInterpolatedY();
+		
 		/** Display the texture facing in the right direction. */
 		virtual void render();
 		
+		/** Save the entity direction, speed and position.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore the entity direction, speed and position.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
+		
 	protected:
 		/** Tell in which direction the entity is facing. */
 		Direction _facingDirection;
@@ -115,6 +140,11 @@ class MovingEntity: public Entity
 		Texture *_pointerTextures[DIRECTIONS_COUNT];
 		/** All entity collision rectangles (one for each direction). */
 		SDL_Rect _positionRectangles[DIRECTIONS_COUNT];
+		
+		/** The entity X coordinate before the last game logic tick. */
+		int _previousX;
+		/** The entity Y coordinate before the last game logic tick. */
+		int _previousY;
 };
 
 #endif
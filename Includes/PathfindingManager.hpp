@@ -0,0 +1,63 @@
+/** @file PathfindingManager.hpp
+ * Find the way to the player around the level walls and enemy spawners. A flow field tells for each level block how many blocks separate it from the player block, so all enemies chasing the player read their next direction from the same data. The flow field is bounded to the blocks close to the player, so its cost does not depend on the level size. Longer paths are found on a graph connecting the places where the level clusters borders can be crossed, so their cost depends on the clusters count instead of the blocks count. The level blocks are also labeled with connected regions, telling at once whether a block can be reached from another one.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_PATHFINDING_MANAGER_HPP
+#define HPP_PATHFINDING_MANAGER_HPP
+
+#include <MovingEntity.hpp>
+#include <vector>
+
+namespace PathfindingManager
+{
+	/** Compute the flow field again if the player reached another block or if the level changed since the last call, otherwise only repair it around the blocks freed by destroyed enemy spawners. Build the clusters graph and label the regions again if the level changed, otherwise only repair them around the freed blocks too. Call it each game logic tick before the enemies are updated. */
+	void update();
+
+	/** Tell which way leads to the player from a level location, following the flow field.
+	* @param x The location X coordinate in pixels.
+	* @param y The location Y coordinate in pixels.
+	* @param pointerDirection On output, contain the direction of the neighbor block that is closer to the player.
+	* @return 1 if a direction was found,
+	* @return 0 if the location is on the player block or if the player can't be reached from it.
+	*/
+	int getFlowFieldDirection(int x, int y, MovingEntity::Direction *pointerDirection);
+
+	/** Find a path between two level blocks on the clusters graph.
+	* @param xStartingBlock The starting block X coordinate in blocks.
+	* @param yStartingBlock The starting block Y coordinate in blocks.
+	* @param xGoalBlock The goal block X coordinate in blocks.
+	* @param yGoalBlock The goal block Y coordinate in blocks.
+	* @param pointerPath On output, contain the indexes of the blocks to go through to reach the goal, the goal block being the last one. Consecutive blocks can be reached from each other without leaving their cluster. The vector is cleared before the blocks are added.
+	* @return 0 if a path was found (it is empty if both blocks are the same),
+	* @return -1 if the goal can't be reached.
+	*/
+	int findPath(int xStartingBlock, int yStartingBlock, int xGoalBlock, int yGoalBlock, std::vector<int> *pointerPath);
+
+	/** Tell which way leads to a goal from a level location. The result is remembered until the level obstacles change close enough to the path, so enemies staying on the same block do not search the path again.
+	* @param x The location X coordinate in pixels.
+	* @param y The location Y coordinate in pixels.
+	* @param goalX The goal X coordinate in pixels.
+	* @param goalY The goal Y coordinate in pixels.
+	* @param pointerDirection On output, contain the direction of the neighbor block that is the first step of the path.
+	* @return 1 if a direction was found,
+	* @return 0 if the location is on the goal block or if the goal can't be reached from it.
+	*/
+	int getPathDirection(int x, int y, int goalX, int goalY, MovingEntity::Direction *pointerDirection);
+
+	/** Tell whether a level location can be reached from another one, without searching a path.
+	* @param x The starting location X coordinate in pixels.
+	* @param y The starting location Y coordinate in pixels.
+	* @param goalX The goal X coordinate in pixels.
+	* @param goalY The goal Y coordinate in pixels.
+	* @return true if both locations are in the same connected region,
+	* @return false if a wall or an enemy spawner separates them, or if a location is outside of the level.
+	*/
+	bool isReachable(int x, int y, int goalX, int goalY);
+
+	/** Get a counter incremented each time the regions are labeled again (when a level is loaded) or when destroyed enemy spawners join some regions. Locations that can't reach each other remain so until the counter changes.
+	* @return The regions version, it is never 0 once update() has been called.
+	*/
+	unsigned int getRegionsVersion();
+}
+
+#endif
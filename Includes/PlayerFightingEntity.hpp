@@ -27,7 +27,7 @@ class PlayerFightingEntity: public FightingEntity
 		// No need for documentation because it is the same as parent function
 		virtual BulletMovingEntity *shoot();
 		
-		/** Generate a mortar shell facing the entity direction and play the associated effect.
+		/** Generate a mortar shell (or a homing rocket if the player owns some) facing the entity direction and play the associated effect. Its explosion damages the entities around it.
 		 * @return A valid pointer if the entity was allowed to shot,
 		 * @return NULL if the entity could not shoot (no more ammunition, slower fire rate...).
 		 */
@@ -66,6 +66,16 @@ class PlayerFightingEntity: public FightingEntity
 		 */
 		virtual int update();
 		
+		/** Save ammunition, homing rockets, mortar reloading state and active bonus in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to write to.
+		 */
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		/** Restore ammunition, homing rockets, mortar reloading state and active bonus (with its skin) in addition to parent classes fields.
+		 * @param pointerSnapshot The snapshot to read from.
+		 */
+		virtual void restoreState(Snapshot *pointerSnapshot);
+		
 	protected:
 		// No need for documentation because it is the same as parent function
 		virtual BulletMovingEntity *_fireBullet(int x, int y);
@@ -86,6 +96,8 @@ class PlayerFightingEntity: public FightingEntity
 		
 		/** How many ammunition the player owns. */
 		int _ammunitionAmount; // Only player has limited ammunition, because what could do a munitions-less enemy ?
+		/** How many homing rockets the player owns, they are shot instead of the next mortar shells. */
+		int _homingRocketsAmount;
 		
 		/** When was the last shot fired (in milliseconds). This is part of the fire rate mechanism. */
 		unsigned int _secondaryFireLastShotTime;
@@ -106,7 +118,7 @@ class PlayerFightingEntity: public FightingEntity
 		SDL_Point _secondaryFireFiringEffectStartingPositionOffsets[DIRECTIONS_COUNT]; // Offsets are in the same order than Direction enum
 };
 
-/** The unique player, which must be accessible to any other module. */
-extern PlayerFightingEntity *pointerPlayer;
+/** The unique player of the calling thread world, which must be accessible to any other module. */
+extern thread_local PlayerFightingEntity *pointerPlayer;
 
 #endif
@@ -0,0 +1,46 @@
+/** @file RandomManager.hpp
+ * Provide independent pseudo-random numbers streams to the game subsystems, so random numbers drawn by a subsystem never change the numbers drawn by another one. All streams are derived from a single seed, making a whole game reproducible.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_RANDOM_MANAGER_HPP
+#define HPP_RANDOM_MANAGER_HPP
+
+#include <Snapshot.hpp>
+
+namespace RandomManager
+{
+	/** All available pseudo-random numbers streams. */
+	typedef enum
+	{
+		STREAM_ID_ENEMY_SPAWN, //!< Choose which enemy a spawner creates.
+		STREAM_ID_ITEM_LOOT, //!< Choose which item a dead enemy drops.
+		STREAM_ID_ENEMY_ARTIFICIAL_INTELLIGENCE, //!< Choose the enemies moving decisions.
+		STREAM_ID_AUDIO, //!< Choose the music to play (it is used by the audio thread, so it must not be used by the game logic). Unlike the other streams, it is shared by all threads.
+		STREAM_ID_BENCHMARK, //!< Place the entities the benchmark scenarios add to the world.
+		STREAM_IDS_COUNT
+	} StreamId;
+
+	/** Seed all streams. Each stream gets a different state derived from the provided seed.
+	* @param seed The value all streams are derived from. Use the same value to get the same numbers.
+	*/
+	void initialize(unsigned int seed);
+
+	/** Draw the next number of a stream.
+	* @param streamId The stream to draw the number from.
+	* @param maximumValue The exclusive upper bound of the generated number, it must be greater than zero.
+	* @return A number in range [0; maximumValue - 1].
+	*/
+	int generateNumber(StreamId streamId, int maximumValue);
+
+	/** Append all streams state to a snapshot.
+	* @param pointerSnapshot The snapshot to write to.
+	*/
+	void saveState(Snapshot *pointerSnapshot);
+
+	/** Restore all streams state, so the same numbers than after saveState() call are drawn again.
+	* @param pointerSnapshot The snapshot to read from.
+	*/
+	void restoreState(Snapshot *pointerSnapshot);
+}
+
+#endif
@@ -0,0 +1,92 @@
+/** @file RectanglesBatch.hpp
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_RECTANGLES_BATCH_HPP
+#define HPP_RECTANGLES_BATCH_HPP
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/** @class RectanglesBatch
+ * Many rectangles stored as separate X, Y, width and height arrays, so one rectangle can be tested against all of them with SIMD instructions (AVX2 or SSE2 when the compiler targets them, plain C++ otherwise). Intersection tests give the same results than SDL_HasIntersection().
+ */
+class RectanglesBatch
+{
+	public:
+		/** Remove all rectangles. The allocated memory is kept, so filling the batch again with the same amount of rectangles does not allocate anything. */
+		void clear();
+		
+		/** Append a rectangle to the batch.
+		 * @param pointerRectangle The rectangle to copy.
+		 * @return The rectangle index in the batch.
+		 */
+		int add(SDL_Rect *pointerRectangle);
+		
+		/** Get a rectangle.
+		 * @param index The rectangle index.
+		 * @param pointerRectangle On output, contain the rectangle.
+		 */
+		void get(int index, SDL_Rect *pointerRectangle);
+		
+		/** Set a rectangle position, keeping its dimensions.
+		 * @param index The rectangle index.
+		 * @param x The new X coordinate.
+		 * @param y The new Y coordinate.
+		 */
+		void setPosition(int index, int x, int y);
+		
+		/** Tell how many rectangles the batch contains.
+		 * @return The rectangles count.
+		 */
+		inline int getCount()
+		{
+			return (int) _x.size();
+		}
+		
+		/** Move a single rectangle.
+		 * @param index The rectangle index.
+		 * @param offsetX How many pixels to add to the rectangle X coordinate.
+		 * @param offsetY How many pixels to add to the rectangle Y coordinate.
+		 */
+		void move(int index, int offsetX, int offsetY);
+		
+		/** Move all rectangles at once.
+		 * @param offsetX How many pixels to add to all X coordinates.
+		 * @param offsetY How many pixels to add to all Y coordinates.
+		 */
+		void moveAll(int offsetX, int offsetY);
+		
+		/** Find the first rectangle of the batch intersecting with another rectangle.
+		 * @param pointerRectangle The rectangle to test against the batch.
+		 * @param startingIndex The index of the first batch rectangle to test, use it to find the next intersections.
+		 * @return -1 if no rectangle intersects,
+		 * @return The index of the first intersecting rectangle.
+		 */
+		int findFirstIntersection(SDL_Rect *pointerRectangle, int startingIndex);
+		
+		/** Test a rectangle against the 32 first rectangles of the batch.
+		 * @param pointerRectangle The rectangle to test against the batch.
+		 * @return A bit field, where bit n is set if the batch rectangle n intersects.
+		 */
+		unsigned int computeIntersectionsMask(SDL_Rect *pointerRectangle);
+	
+	private:
+		/** All rectangles X coordinate. */
+		std::vector<int> _x;
+		/** All rectangles Y coordinate. */
+		std::vector<int> _y;
+		/** All rectangles width. */
+		std::vector<int> _widths;
+		/** All rectangles height. */
+		std::vector<int> _heights;
+		
+		/** Test a rectangle against a range of the batch rectangles.
+		 * @param pointerRectangle The rectangle to test.
+		 * @param startingIndex The first batch rectangle to test.
+		 * @param count How many batch rectangles to test, it must not exceed 32.
+		 * @return A bit field, where bit n is set if the batch rectangle (startingIndex + n) intersects.
+		 */
+		unsigned int _computeRangeIntersectionsMask(SDL_Rect *pointerRectangle, int startingIndex, int count);
+};
+
+#endif
@@ -31,7 +31,7 @@ namespace Renderer
 		FONT_SIZE_IDS_COUNT
 	} FontSizeId;
 
-	/** The renderer used to render to the game window. */
+	/** The renderer used to render to the game window. It is NULL when the game runs in headless mode (no window is created). */
 	extern SDL_Renderer *pointerRenderer;
 
 	/** Contains the visible display (it can be though as the camera) leftmost coordinate. */
@@ -39,6 +39,9 @@ namespace Renderer
 	/** Contains the visible display (it can be though as the camera) topmost coordinate. */
 	extern int displayY;
 
+	/** How far the rendered frame is between the previous game logic tick and the current one, in range [0; 1]. Moving entities positions are interpolated with this value. */
+	extern float ticksInterpolationFactor;
+
 	/** The display width in pixels. */
 	extern int displayWidth;
 	/** The display height in pixels. */
@@ -67,6 +70,7 @@ namespace Renderer
 	* @param colorId The text color.
 	* @param fontSizeId The font size.
 	* @return A texture containing the rendered text. Caller must free this texture.
+	* @return NULL in headless mode.
 	* @warning This function halts the game if something goes wrong.
 	*/
 	SDL_Texture *renderTextToTexture(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId);
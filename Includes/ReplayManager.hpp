@@ -0,0 +1,70 @@
+/** @file ReplayManager.hpp
+ * Record the player inputs of each game logic tick to a file, then replay them exactly. A world state hash is stored for each tick, so any divergence is detected as soon as it happens.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_REPLAY_MANAGER_HPP
+#define HPP_REPLAY_MANAGER_HPP
+
+namespace ReplayManager
+{
+	/** Everything needed to start a game in the same state than the recorded one. */
+	typedef struct
+	{
+		unsigned int randomSeed; //!< The value used to seed the pseudo-random numbers generators.
+		int levelNumber; //!< The level the game starts from.
+		int playerMaximumLifePoints; //!< The player maximum (and starting) life points amount.
+		int playerAmmunition; //!< The player starting ammunition amount.
+		int displayWidth; //!< Display width in pixels (enemies spotting and shooting distances, as well as bullets range, depend on it).
+		int displayHeight; //!< Display height in pixels.
+	} ReplayHeader;
+
+	/** Create a replay file and write its header.
+	* @param pointerStringFileName The file to create.
+	* @param pointerHeader The game starting conditions.
+	* @return 0 if the recording started,
+	* @return -1 if an error occurred.
+	*/
+	int startRecording(const char *pointerStringFileName, ReplayHeader *pointerHeader);
+
+	/** Append a game logic tick to the replay file. Nothing is done if no recording is in progress.
+	* @param keysState The gameplay keys state used during the tick (see ControlManager::getGameplayKeysState()).
+	* @param worldHash The world state hash computed at the end of the tick.
+	*/
+	void recordTick(unsigned int keysState, unsigned int worldHash);
+
+	/** Close the replay file (nothing is done if no recording is in progress). */
+	void stopRecording();
+
+	/** Tell whether ticks are being recorded.
+	* @return true if a recording is in progress,
+	* @return false if no recording is in progress.
+	*/
+	bool isRecording();
+
+	/** Open a replay file and read its header.
+	* @param pointerStringFileName The file to replay.
+	* @param pointerHeader On output, contain the game starting conditions.
+	* @return 0 if the replay file can be played,
+	* @return -1 if an error occurred.
+	*/
+	int startPlayback(const char *pointerStringFileName, ReplayHeader *pointerHeader);
+
+	/** Read the next recorded game logic tick.
+	* @param pointerKeysState On output, contain the gameplay keys state to use for this tick.
+	* @param pointerWorldHash On output, contain the world state hash expected at the end of the tick.
+	* @return 0 if the tick was successfully read,
+	* @return 1 if the end of the replay has been reached.
+	*/
+	int playTick(unsigned int *pointerKeysState, unsigned int *pointerWorldHash);
+
+	/** Close the replay file (nothing is done if no playback is in progress). */
+	void stopPlayback();
+
+	/** Tell whether a replay is being played.
+	* @return true if a playback is in progress,
+	* @return false if no playback is in progress.
+	*/
+	bool isPlaying();
+}
+
+#endif
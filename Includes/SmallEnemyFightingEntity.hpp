@@ -20,6 +20,9 @@ class SmallEnemyFightingEntity: public EnemyFightingEntity
 		
 		/** Free allocated resources. */
 		virtual ~SmallEnemyFightingEntity();
+		
+		// No need for documentation because it is the same as parent function
+		virtual EnemyType getType();
 
 	protected:
 		// No need for documentation because it is the same as parent function
@@ -0,0 +1,95 @@
+/** @file Snapshot.hpp
+ * Store the world state as a binary blob, which can be kept in memory to be restored instantly or written to a file.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_SNAPSHOT_HPP
+#define HPP_SNAPSHOT_HPP
+
+#include <vector>
+
+/** @class Snapshot
+ * A binary blob holding a sequence of 32-bit values, used to save the whole world state and to restore it later. Values are stored in little endian, so a snapshot file can be exchanged between all platforms.
+ */
+class Snapshot
+{
+	public:
+		/** Create an empty snapshot. */
+		Snapshot();
+		
+		/** Discard the snapshot content to write a new one. The allocated memory is kept, so writing a snapshot of the same size again does not allocate anything. */
+		void beginWriting();
+		
+		/** Append a value to the snapshot.
+		 * @param value The value to write.
+		 */
+		void writeInteger(int value);
+		
+		/** Append a value to the snapshot.
+		 * @param value The value to write.
+		 */
+		void writeUnsignedInteger(unsigned int value);
+		
+		/** Start reading the snapshot from its first value. */
+		void beginReading();
+		
+		/** Read the next value.
+		 * @return The read value, or 0 if the snapshot end was reached (see isReadingFailed()).
+		 */
+		int readInteger();
+		
+		/** Read the next value.
+		 * @return The read value, or 0 if the snapshot end was reached (see isReadingFailed()).
+		 */
+		unsigned int readUnsignedInteger();
+		
+		/** Tell whether a value was read beyond the snapshot end since reading began, which means that the snapshot is truncated or corrupted.
+		 * @return true if a read failed,
+		 * @return false if all reads succeeded.
+		 */
+		inline bool isReadingFailed()
+		{
+			return _isReadingFailed;
+		}
+		
+		/** Tell whether the snapshot contains something.
+		 * @return true if the snapshot has no content,
+		 * @return false if something was written or loaded.
+		 */
+		inline bool isEmpty()
+		{
+			return _data.empty();
+		}
+		
+		/** Get the snapshot size.
+		 * @return The snapshot size in bytes.
+		 */
+		inline int getSize()
+		{
+			return (int) _data.size();
+		}
+		
+		/** Write the snapshot content to a file.
+		 * @param pointerStringFileName The file to create.
+		 * @return 0 if the file was successfully written,
+		 * @return -1 if an error occurred.
+		 */
+		int saveToFile(const char *pointerStringFileName);
+		
+		/** Replace the snapshot content by a file content.
+		 * @param pointerStringFileName The file to load.
+		 * @return 0 if the file was successfully loaded,
+		 * @return -1 if an error occurred (the snapshot is empty then).
+		 */
+		int loadFromFile(const char *pointerStringFileName);
+	
+	private:
+		/** The snapshot content. */
+		std::vector<unsigned char> _data;
+		
+		/** Where the next value will be read from. */
+		unsigned int _readingOffset;
+		/** Set when a value could not be read. */
+		bool _isReadingFailed;
+};
+
+#endif
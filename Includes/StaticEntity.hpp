@@ -41,6 +41,12 @@ class StaticEntity: public Entity
 		
 		// No need for documentation because it is the same as parent function
 		virtual SDL_Rect *getPositionRectangle();
+		
+		// No need for documentation because it is the same as parent function
+		virtual void saveState(Snapshot *pointerSnapshot);
+		
+		// No need for documentation because it is the same as parent function
+		virtual void restoreState(Snapshot *pointerSnapshot);
 
 	protected:
 		/** The texture used to render the entity. */
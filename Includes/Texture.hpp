@@ -17,6 +17,13 @@ class Texture
 		 */
 		Texture(SDL_Texture *pointerSDLTexture);
 		
+		/** Create a still texture whose dimensions are already known, without querying the SDL texture.
+		 * @param pointerSDLTexture The SDL texture to display. It can be NULL when no renderer is available (headless mode), the texture then only provides its dimensions.
+		 * @param width The texture width in pixels.
+		 * @param height The texture height in pixels.
+		 */
+		Texture(SDL_Texture *pointerSDLTexture, int width, int height);
+		
 		/** Free allocated resources. */
 		virtual ~Texture() {}
 		
@@ -171,7 +171,7 @@ namespace TextureManager
 		TEXTURE_IDS_COUNT
 	} TextureId;
 
-	/** Load all game textures.
+	/** Load all game textures. When no renderer has been created (headless mode), only textures dimensions are loaded.
 	* @return 0 if all textures were successfully initialized,
 	* @return -1 if an error occurred.
 	*/
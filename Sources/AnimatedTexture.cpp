@@ -6,7 +6,7 @@
 #include <Log.hpp>
 #include <Renderer.hpp>
 
-AnimatedTexture::AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping): Texture(pointerSDLTexture)
+AnimatedTexture::AnimatedTexture(SDL_Texture *pointerSDLTexture, int width, int height, int imagesCount, int framesPerImageCount, bool isAnimationLooping): Texture(pointerSDLTexture, width, height)
 {
 	_currentImageIndex = 0;
 	_framesCounter = 0;
@@ -19,7 +19,7 @@ AnimatedTexture::AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount
 	LOG_DEBUG("Created animated texture. Single image width : %d, single image height : %d.", _width, _height);
 }
 
-int AnimatedTexture::render(int x, int y)
+int AnimatedTexture::update()
 {
 	// Should the next image be displayed ?
 	_framesCounter++;
@@ -36,6 +36,24 @@ int AnimatedTexture::render(int x, int y)
 		_framesCounter = 0;
 	}
 	
+	return 0;
+}
+
+void AnimatedTexture::saveState(Snapshot *pointerSnapshot)
+{
+	pointerSnapshot->writeInteger(_currentImageIndex);
+	pointerSnapshot->writeInteger(_framesCounter);
+}
+
+void AnimatedTexture::restoreState(Snapshot *pointerSnapshot)
+{
+	_currentImageIndex = pointerSnapshot->readInteger();
+	if ((_currentImageIndex < 0) || (_currentImageIndex >= _imagesCount)) _currentImageIndex = 0; // Do not render outside of the texture if the snapshot is corrupted
+	_framesCounter = pointerSnapshot->readInteger();
+}
+
+int AnimatedTexture::render(int x, int y)
+{
 	// Set texture position on display
 	SDL_Rect positionRectangle;
 	positionRectangle.x = x;
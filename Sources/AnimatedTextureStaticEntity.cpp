@@ -18,10 +18,28 @@ AnimatedTextureStaticEntity::~AnimatedTextureStaticEntity()
 void AnimatedTextureStaticEntity::render()
 {
 	// Display the animation current image
-	if (_pointerTexture->render(_positionRectangle.x - Renderer::displayX, _positionRectangle.y - Renderer::displayY) != 0) _isAnimationTerminated = 1;
+	_pointerTexture->render(_positionRectangle.x - Renderer::displayX, _positionRectangle.y - Renderer::displayY);
 }
 
 int AnimatedTextureStaticEntity::update()
 {
+	// Advance the animation even if it is not displayed
+	if (static_cast<AnimatedTexture *>(_pointerTexture)->update() != 0) _isAnimationTerminated = 1;
 	return _isAnimationTerminated;
 }
+
+void AnimatedTextureStaticEntity::saveState(Snapshot *pointerSnapshot)
+{
+	StaticEntity::saveState(pointerSnapshot);
+	
+	static_cast<AnimatedTexture *>(_pointerTexture)->saveState(pointerSnapshot);
+	pointerSnapshot->writeInteger(_isAnimationTerminated);
+}
+
+void AnimatedTextureStaticEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	StaticEntity::restoreState(pointerSnapshot);
+	
+	static_cast<AnimatedTexture *>(_pointerTexture)->restoreState(pointerSnapshot);
+	_isAnimationTerminated = pointerSnapshot->readInteger();
+}
@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <FileManager.hpp>
 #include <Log.hpp>
+#include <RandomManager.hpp>
 #include <SDL2/SDL.h>
 #ifdef CONFIGURATION_BUILD_FOR_MACOS
 	#include <SDL2_mixer/SDL_mixer.h>
@@ -110,6 +111,9 @@ namespace AudioManager
 	/** Tell the thread it must exit. */
 	//static volatile int _isThreadTerminated = 0;
 
+	/** Set to true when the audio mixer has been successfully opened, sounds are silently ignored otherwise (for instance in headless mode). */
+	static bool _isInitialized = false;
+
 	/** Load a sound from a wave file.
 	* @param pointerStringFileName The file to load.
 	* @return A pointer on the chunk containing the sound.
@@ -228,6 +232,7 @@ namespace AudioManager
 		// 	return -1;
 		// }
 		
+		_isInitialized = true;
 		return 0;
 	}
 
@@ -256,6 +261,8 @@ namespace AudioManager
 
 	void playSound(SoundId id)
 	{
+		if (!_isInitialized) return;
+		
 		if (id < SOUND_IDS_COUNT)
 		{
 			// Try to play the sound on the first available channel
@@ -266,7 +273,7 @@ namespace AudioManager
 	void playMusic()
 	{
 		// Select a random music
-		int musicIndex = rand() % MUSICS_COUNT;
+		int musicIndex = RandomManager::generateNumber(RandomManager::STREAM_ID_AUDIO, MUSICS_COUNT);
 		
 		// Try to play it
 		if (Mix_PlayMusic(_musics[musicIndex].pointerMusicHandle, 1) != 0) LOG_ERROR("Failed to play music %s (%s).", _musics[musicIndex].pointerStringFileName, Mix_GetError());
@@ -281,6 +288,8 @@ namespace AudioManager
 
 	void stopAllSounds()
 	{
+		if (!_isInitialized) return;
+		
 		Mix_HaltChannel(-1);
 	}
 }
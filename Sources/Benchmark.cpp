@@ -0,0 +1,293 @@
+/** @file Benchmark.cpp
+ * See Benchmark.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Benchmark.hpp>
+
+#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+
+#include <cerrno>
+#include <Configuration.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <Log.hpp>
+#include <new>
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Allocations counting
+//-------------------------------------------------------------------------------------------------
+/** How many allocations the calling thread did since the program started. */
+static thread_local unsigned long long _allocationsCount = 0;
+/** How many bytes the calling thread allocated since the program started. */
+static thread_local unsigned long long _allocatedBytesCount = 0;
+
+// Replace the global allocation functions to count the game logic allocations
+void *operator new(size_t size)
+{
+	_allocationsCount++;
+	_allocatedBytesCount += size;
+	
+	void *pointerBuffer = malloc(size);
+	if (pointerBuffer == NULL) throw std::bad_alloc();
+	return pointerBuffer;
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *pointerBuffer) noexcept
+{
+	free(pointerBuffer);
+}
+
+void operator delete[](void *pointerBuffer) noexcept
+{
+	free(pointerBuffer);
+}
+
+namespace Benchmark
+{
+	/** The name of each phase in the results file. */
+	static const char *PHASES_NAMES[PHASE_IDS_COUNT] =
+	{
+		"inputs",
+		"player",
+		"player_bullets",
+		"enemies",
+		"enemies_bullets",
+		"enemy_spawners",
+		"effects"
+	};
+
+	/** The measurements of a whole scenario. */
+	typedef struct
+	{
+		std::string name; //!< The scenario file name without its path nor its extension.
+		Scenario scenario; //!< The scenario parameters.
+		int executedTicksCount; //!< How many ticks were executed (it is less than the requested amount if the game ended before).
+		unsigned long long phasesDurations[PHASE_IDS_COUNT]; //!< Each phase total duration, in performance counter units.
+		unsigned long long enemiesCountsSum; //!< The sum of the amount of alive enemies at each tick end.
+		unsigned long long enemySpawnersCountsSum; //!< The sum of the amount of alive enemy spawners at each tick end.
+		unsigned long long playerBulletsCountsSum; //!< The sum of the amount of alive player bullets at each tick end.
+		unsigned long long enemiesBulletsCountsSum; //!< The sum of the amount of alive enemies bullets at each tick end.
+		unsigned long long allocationsCount; //!< How many allocations were done during the scenario.
+		unsigned long long allocatedBytesCount; //!< How many bytes were allocated during the scenario.
+	} ScenarioResult;
+
+	/** The scenario being measured. */
+	static ScenarioResult _currentResult;
+	/** The phase being measured. */
+	static PhaseId _currentPhaseId;
+	/** The performance counter value when the current phase began. */
+	static Uint64 _currentPhaseStartingTime;
+	/** The allocations count when the scenario began. */
+	static unsigned long long _startingAllocationsCount;
+	/** The allocated bytes count when the scenario began. */
+	static unsigned long long _startingAllocatedBytesCount;
+
+	/** All ended scenarios measurements. */
+	static std::vector<ScenarioResult> _results;
+
+	int loadScenario(const char *pointerStringFileName, Scenario *pointerScenario)
+	{
+		char stringLine[256], stringName[64];
+		int value, lineNumber = 0;
+		
+		// Set default values
+		pointerScenario->levelNumber = 0;
+		pointerScenario->enemiesCount = 0;
+		pointerScenario->smallEnemiesPercentage = CONFIGURATION_GAMEPLAY_SMALL_ENEMY_SPAWN_PROBABILITY_PERCENTAGE;
+		pointerScenario->mediumEnemiesPercentage = CONFIGURATION_GAMEPLAY_MEDIUM_ENEMY_SPAWN_PROBABILITY_PERCENTAGE;
+		pointerScenario->bulletsPerSecond = 0;
+		pointerScenario->ticksCount = CONFIGURATION_HEADLESS_DEFAULT_TICKS_COUNT;
+		pointerScenario->randomSeed = 0;
+		pointerScenario->isBotEnabled = false;
+		
+		// Try to open the file
+		FILE *pointerFile = fopen(pointerStringFileName, "r");
+		if (pointerFile == NULL)
+		{
+			LOG_ERROR("Could not open scenario file '%s' (%s).", pointerStringFileName, strerror(errno));
+			return -1;
+		}
+		
+		while (fgets(stringLine, sizeof(stringLine), pointerFile) != NULL)
+		{
+			lineNumber++;
+			
+			// Ignore comments and empty lines
+			if (sscanf(stringLine, "%63s", stringName) != 1) continue;
+			if (stringName[0] == '#') continue;
+			
+			if (sscanf(stringLine, "%63s %d", stringName, &value) != 2)
+			{
+				LOG_ERROR("Scenario file '%s' line %d has no value.", pointerStringFileName, lineNumber);
+				goto Exit_Error;
+			}
+			
+			if (strcmp(stringName, "level") == 0) pointerScenario->levelNumber = value;
+			else if (strcmp(stringName, "enemies") == 0) pointerScenario->enemiesCount = value;
+			else if (strcmp(stringName, "small_enemies_percentage") == 0) pointerScenario->smallEnemiesPercentage = value;
+			else if (strcmp(stringName, "medium_enemies_percentage") == 0) pointerScenario->mediumEnemiesPercentage = value;
+			else if (strcmp(stringName, "bullets_per_second") == 0) pointerScenario->bulletsPerSecond = value;
+			else if (strcmp(stringName, "ticks") == 0) pointerScenario->ticksCount = value;
+			else if (strcmp(stringName, "seed") == 0) pointerScenario->randomSeed = (unsigned int) value;
+			else if (strcmp(stringName, "bot") == 0) pointerScenario->isBotEnabled = (value != 0);
+			else
+			{
+				LOG_ERROR("Scenario file '%s' line %d contains the unknown value '%s'.", pointerStringFileName, lineNumber, stringName);
+				goto Exit_Error;
+			}
+		}
+		
+		// Make sure the scenario can be played
+		if ((pointerScenario->levelNumber < 0) || (pointerScenario->levelNumber >= CONFIGURATION_LEVELS_COUNT) || (pointerScenario->enemiesCount < 0) || (pointerScenario->bulletsPerSecond < 0) || (pointerScenario->ticksCount <= 0))
+		{
+			LOG_ERROR("Scenario file '%s' contains out of range values.", pointerStringFileName);
+			goto Exit_Error;
+		}
+		if ((pointerScenario->smallEnemiesPercentage < 0) || (pointerScenario->mediumEnemiesPercentage < 0) || (pointerScenario->smallEnemiesPercentage + pointerScenario->mediumEnemiesPercentage > 100))
+		{
+			LOG_ERROR("Scenario file '%s' enemies percentages are bad.", pointerStringFileName);
+			goto Exit_Error;
+		}
+		
+		fclose(pointerFile);
+		return 0;
+	
+	Exit_Error:
+		fclose(pointerFile);
+		return -1;
+	}
+
+	void beginScenario()
+	{
+		memset(_currentResult.phasesDurations, 0, sizeof(_currentResult.phasesDurations));
+		_currentResult.executedTicksCount = 0;
+		_currentResult.enemiesCountsSum = 0;
+		_currentResult.enemySpawnersCountsSum = 0;
+		_currentResult.playerBulletsCountsSum = 0;
+		_currentResult.enemiesBulletsCountsSum = 0;
+		
+		_startingAllocationsCount = _allocationsCount;
+		_startingAllocatedBytesCount = _allocatedBytesCount;
+	}
+
+	void beginTick()
+	{
+		_currentPhaseId = PHASE_ID_INPUTS;
+		_currentPhaseStartingTime = SDL_GetPerformanceCounter();
+	}
+
+	void beginPhase(PhaseId phaseId)
+	{
+		Uint64 currentTime = SDL_GetPerformanceCounter();
+		
+		_currentResult.phasesDurations[_currentPhaseId] += currentTime - _currentPhaseStartingTime;
+		_currentPhaseId = phaseId;
+		_currentPhaseStartingTime = currentTime;
+	}
+
+	void endTick(int enemiesCount, int enemySpawnersCount, int playerBulletsCount, int enemiesBulletsCount)
+	{
+		_currentResult.phasesDurations[_currentPhaseId] += SDL_GetPerformanceCounter() - _currentPhaseStartingTime;
+		
+		_currentResult.executedTicksCount++;
+		_currentResult.enemiesCountsSum += enemiesCount;
+		_currentResult.enemySpawnersCountsSum += enemySpawnersCount;
+		_currentResult.playerBulletsCountsSum += playerBulletsCount;
+		_currentResult.enemiesBulletsCountsSum += enemiesBulletsCount;
+	}
+
+	void endScenario(const char *pointerStringFileName, Scenario *pointerScenario)
+	{
+		_currentResult.allocationsCount = _allocationsCount - _startingAllocationsCount;
+		_currentResult.allocatedBytesCount = _allocatedBytesCount - _startingAllocatedBytesCount;
+		_currentResult.scenario = *pointerScenario;
+		
+		// Name the scenario from its file name
+		const char *pointerStringName = strrchr(pointerStringFileName, '/');
+		if (pointerStringName == NULL) pointerStringName = pointerStringFileName;
+		else pointerStringName++;
+		_currentResult.name = pointerStringName;
+		size_t extensionPosition = _currentResult.name.rfind('.');
+		if (extensionPosition != std::string::npos) _currentResult.name.erase(extensionPosition);
+		
+		_results.push_back(_currentResult);
+	}
+
+	int writeResults(const char *pointerStringFileName)
+	{
+		unsigned int i;
+		int j;
+		double ticksCount, nanosecondsPerCounterUnit = 1e9 / SDL_GetPerformanceFrequency(), totalDuration;
+		ScenarioResult *pointerResult;
+		
+		// Try to create the file
+		FILE *pointerFile = fopen(pointerStringFileName, "w");
+		if (pointerFile == NULL)
+		{
+			LOG_ERROR("Could not create benchmark results file '%s' (%s).", pointerStringFileName, strerror(errno));
+			return -1;
+		}
+		
+		fprintf(pointerFile, "{\n\t\"scenarios\": [");
+		for (i = 0; i < _results.size(); i++)
+		{
+			pointerResult = &_results[i];
+			ticksCount = pointerResult->executedTicksCount > 0 ? pointerResult->executedTicksCount : 1; // Avoid dividing by zero
+			
+			// Scenario parameters
+			fprintf(pointerFile, "%s\n\t\t{\n", i > 0 ? "," : "");
+			fprintf(pointerFile, "\t\t\t\"name\": \"%s\",\n", pointerResult->name.c_str());
+			fprintf(pointerFile, "\t\t\t\"level\": %d,\n", pointerResult->scenario.levelNumber);
+			fprintf(pointerFile, "\t\t\t\"spawned_enemies\": %d,\n", pointerResult->scenario.enemiesCount);
+			fprintf(pointerFile, "\t\t\t\"bullets_per_second\": %d,\n", pointerResult->scenario.bulletsPerSecond);
+			fprintf(pointerFile, "\t\t\t\"bot\": %s,\n", pointerResult->scenario.isBotEnabled ? "true" : "false");
+			fprintf(pointerFile, "\t\t\t\"requested_ticks\": %d,\n", pointerResult->scenario.ticksCount);
+			fprintf(pointerFile, "\t\t\t\"executed_ticks\": %d,\n", pointerResult->executedTicksCount);
+			
+			// Phases durations
+			totalDuration = 0;
+			fprintf(pointerFile, "\t\t\t\"nanoseconds_per_tick\": {\n");
+			for (j = 0; j < PHASE_IDS_COUNT; j++)
+			{
+				fprintf(pointerFile, "\t\t\t\t\"%s\": %.1f,\n", PHASES_NAMES[j], (pointerResult->phasesDurations[j] * nanosecondsPerCounterUnit) / ticksCount);
+				totalDuration += pointerResult->phasesDurations[j];
+			}
+			fprintf(pointerFile, "\t\t\t\t\"total\": %.1f\n\t\t\t},\n", (totalDuration * nanosecondsPerCounterUnit) / ticksCount);
+			
+			// Entities
+			fprintf(pointerFile, "\t\t\t\"average_alive_entities\": {\n");
+			fprintf(pointerFile, "\t\t\t\t\"enemies\": %.1f,\n", pointerResult->enemiesCountsSum / ticksCount);
+			fprintf(pointerFile, "\t\t\t\t\"enemy_spawners\": %.1f,\n", pointerResult->enemySpawnersCountsSum / ticksCount);
+			fprintf(pointerFile, "\t\t\t\t\"player_bullets\": %.1f,\n", pointerResult->playerBulletsCountsSum / ticksCount);
+			fprintf(pointerFile, "\t\t\t\t\"enemies_bullets\": %.1f\n\t\t\t},\n", pointerResult->enemiesBulletsCountsSum / ticksCount);
+			
+			// Allocations
+			fprintf(pointerFile, "\t\t\t\"allocations\": {\n");
+			fprintf(pointerFile, "\t\t\t\t\"count\": %llu,\n", pointerResult->allocationsCount);
+			fprintf(pointerFile, "\t\t\t\t\"bytes\": %llu,\n", pointerResult->allocatedBytesCount);
+			fprintf(pointerFile, "\t\t\t\t\"per_tick\": %.2f\n\t\t\t}\n", pointerResult->allocationsCount / ticksCount);
+			fprintf(pointerFile, "\t\t}");
+		}
+		fprintf(pointerFile, "\n\t]\n}\n");
+		
+		if (ferror(pointerFile))
+		{
+			LOG_ERROR("Failed to write benchmark results file '%s'.", pointerStringFileName);
+			fclose(pointerFile);
+			return -1;
+		}
+		fclose(pointerFile);
+		return 0;
+	}
+}
+
+#endif
@@ -4,18 +4,22 @@
  */
 #include <BigEnemyFightingEntity.hpp>
 #include <EffectManager.hpp>
-#include <SDL2/SDL.h>
+#include <GameClock.hpp>
 #include <TextureManager.hpp>
 
 BigEnemyFightingEntity::BigEnemyFightingEntity(int x, int y): EnemyFightingEntity(x, y, TextureManager::TEXTURE_ID_BIG_ENEMY_FACING_UP, 1, 10, 10000, TextureManager::TEXTURE_ID_BIG_ENEMY_BULLET_FACING_UP, EffectManager::EFFECT_ID_BIG_ENEMY_MUZZLE_FLASH_FACING_UP, EffectManager::EFFECT_ID_BIG_ENEMY_EXPLOSION)
 {
 	// Make big enemies wait 3 seconds before shooting (to avoid them shooting instantly when spawned)
-	unsigned int currentTime = SDL_GetTicks();
-	if (currentTime > 7000) _lastShotTime = currentTime - 7000;
+	_lastShotTime = GameClock::getTime() - 7000;
 }
 
 BigEnemyFightingEntity::~BigEnemyFightingEntity() {}
 
+EnemyFightingEntity::EnemyType BigEnemyFightingEntity::getType()
+{
+	return ENEMY_TYPE_BIG;
+}
+
 int BigEnemyFightingEntity::update()
 {
 	// Update textures to show enemy damage state
@@ -51,6 +55,21 @@ int BigEnemyFightingEntity::update()
 	return EnemyFightingEntity::update();
 }
 
+void BigEnemyFightingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	TextureManager::TextureId facingUpTextureId;
+	
+	EnemyFightingEntity::restoreState(pointerSnapshot);
+	
+	// Show the damage state update() displayed when the enemy reached this life points amount
+	if (_lifePointsAmount <= 2) facingUpTextureId = TextureManager::TEXTURE_ID_BIG_ENEMY_DAMAGED_4_FACING_UP;
+	else if (_lifePointsAmount <= 4) facingUpTextureId = TextureManager::TEXTURE_ID_BIG_ENEMY_DAMAGED_3_FACING_UP;
+	else if (_lifePointsAmount <= 6) facingUpTextureId = TextureManager::TEXTURE_ID_BIG_ENEMY_DAMAGED_2_FACING_UP;
+	else if (_lifePointsAmount <= 8) facingUpTextureId = TextureManager::TEXTURE_ID_BIG_ENEMY_DAMAGED_1_FACING_UP;
+	else facingUpTextureId = TextureManager::TEXTURE_ID_BIG_ENEMY_FACING_UP;
+	for (int i = 0; i < DIRECTIONS_COUNT; i++) _pointerTextures[i] = TextureManager::getTextureFromId((TextureManager::TextureId) (facingUpTextureId + i)); // Facing down, left and right textures follow the facing up one
+}
+
 BulletMovingEntity *BigEnemyFightingEntity::_fireBullet(int x, int y)
 {
 	return new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_BIG_ENEMY_BULLET_FACING_UP, 4, _facingDirection, 20, 0);
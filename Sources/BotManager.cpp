@@ -0,0 +1,300 @@
+/** @file BotManager.cpp
+ * See BotManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <BotManager.hpp>
+#include <Configuration.hpp>
+#include <ControlManager.hpp>
+#include <cstdlib>
+#include <LevelManager.hpp>
+#include <PlayerFightingEntity.hpp>
+#include <vector>
+
+namespace BotManager
+{
+	/** The key to press to go or to shoot in each direction (use MovingEntity::Direction values as index). */
+	static const ControlManager::KeyId DIRECTION_KEY_IDS[MovingEntity::DIRECTIONS_COUNT] =
+	{
+		ControlManager::KEY_ID_GO_UP,
+		ControlManager::KEY_ID_GO_DOWN,
+		ControlManager::KEY_ID_GO_LEFT,
+		ControlManager::KEY_ID_GO_RIGHT
+	};
+	/** Horizontal offset to add to a block X coordinate to get the neighbor block in each direction. */
+	static const int NEIGHBOR_BLOCKS_OFFSETS_X[MovingEntity::DIRECTIONS_COUNT] = { 0, 0, -1, 1 };
+	/** Vertical offset to add to a block Y coordinate to get the neighbor block in each direction. */
+	static const int NEIGHBOR_BLOCKS_OFFSETS_Y[MovingEntity::DIRECTIONS_COUNT] = { -1, 1, 0, 0 };
+
+	/** The block each visited block was reached from when the route was computed, or -1 if the block was not visited. */
+	static thread_local std::vector<int> &_blocksParentIndexes = *new std::vector<int>(); // Never destroyed, like the other world lists
+	/** The blocks that are waiting to be visited when the route is computed. */
+	static thread_local std::vector<int> &_blocksQueue = *new std::vector<int>();
+
+	/** The block the player was on when the route was computed. */
+	static thread_local int _routeStartingBlockIndex = -1;
+	/** The block the player must go to next, or -1 if no goal can be reached. */
+	static thread_local int _nextBlockIndex = -1;
+	/** How many ticks remain before the route is computed again. */
+	static thread_local int _routeRemainingTicksCount = 0;
+
+	/** Tell whether the player can walk on a block.
+	* @param xBlock The block X coordinate in blocks.
+	* @param yBlock The block Y coordinate in blocks.
+	* @return true if the block is not a wall nor an enemy spawner,
+	* @return false if the player can't cross the block.
+	*/
+	static inline bool _isBlockCrossable(int xBlock, int yBlock)
+	{
+		return (LevelManager::getBlockContent(xBlock * CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) & (LevelManager::BLOCK_CONTENT_WALL | LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER)) == 0;
+	}
+
+	/** Tell whether the bot wants to go to a block.
+	* @param xBlock The block X coordinate in blocks.
+	* @param yBlock The block Y coordinate in blocks.
+	* @param goalContent The block contents the bot is looking for.
+	* @param isEnemySpawnerTargeted Set to true to make the blocks next to an enemy spawner goals, so the spawner can be shot from them.
+	* @return true if the block is a goal,
+	* @return false if it is not.
+	*/
+	static bool _isGoalBlock(int xBlock, int yBlock, int goalContent, bool isEnemySpawnerTargeted)
+	{
+		int i, xNeighborBlock, yNeighborBlock;
+		
+		if (LevelManager::getBlockContent(xBlock * CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) & goalContent) return true;
+		if (!isEnemySpawnerTargeted) return false;
+		
+		for (i = 0; i < MovingEntity::DIRECTIONS_COUNT; i++)
+		{
+			xNeighborBlock = xBlock + NEIGHBOR_BLOCKS_OFFSETS_X[i];
+			yNeighborBlock = yBlock + NEIGHBOR_BLOCKS_OFFSETS_Y[i];
+			if ((xNeighborBlock < 0) || (xNeighborBlock >= LevelManager::getLevelWidthBlocks()) || (yNeighborBlock < 0) || (yNeighborBlock >= LevelManager::getLevelHeightBlocks())) continue;
+			if (LevelManager::getBlockContent(xNeighborBlock * CONFIGURATION_LEVEL_BLOCK_SIZE, yNeighborBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) & LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER) return true;
+		}
+		return false;
+	}
+
+	/** Find the shortest route from a block to the nearest goal with a breadth-first search over the level blocks.
+	* @param startingBlockIndex The block the route starts from.
+	* @param goalContent The block contents the bot is looking for.
+	* @param isEnemySpawnerTargeted Set to true to make the blocks next to an enemy spawner goals.
+	* @return The first block of the route (it is the starting block if this block is a goal),
+	* @return -1 if no goal can be reached.
+	*/
+	static int _computeNextBlockIndex(int startingBlockIndex, int goalContent, bool isEnemySpawnerTargeted)
+	{
+		int levelWidthBlocks = LevelManager::getLevelWidthBlocks(), levelHeightBlocks = LevelManager::getLevelHeightBlocks(), queueReadingIndex, blockIndex, xBlock, yBlock, xNeighborBlock, yNeighborBlock, neighborBlockIndex, i;
+		
+		_blocksParentIndexes.assign(levelWidthBlocks * levelHeightBlocks, -1);
+		_blocksQueue.clear();
+		_blocksParentIndexes[startingBlockIndex] = startingBlockIndex;
+		_blocksQueue.push_back(startingBlockIndex);
+		
+		// Visit the blocks by increasing distance from the starting block, so the first found goal is the nearest one
+		for (queueReadingIndex = 0; queueReadingIndex < (int) _blocksQueue.size(); queueReadingIndex++)
+		{
+			blockIndex = _blocksQueue[queueReadingIndex];
+			xBlock = blockIndex % levelWidthBlocks;
+			yBlock = blockIndex / levelWidthBlocks;
+			
+			if (_isGoalBlock(xBlock, yBlock, goalContent, isEnemySpawnerTargeted))
+			{
+				// Walk the route back to find its first block
+				while (_blocksParentIndexes[blockIndex] != startingBlockIndex) blockIndex = _blocksParentIndexes[blockIndex];
+				return blockIndex;
+			}
+			
+			for (i = 0; i < MovingEntity::DIRECTIONS_COUNT; i++)
+			{
+				xNeighborBlock = xBlock + NEIGHBOR_BLOCKS_OFFSETS_X[i];
+				yNeighborBlock = yBlock + NEIGHBOR_BLOCKS_OFFSETS_Y[i];
+				if ((xNeighborBlock < 0) || (xNeighborBlock >= levelWidthBlocks) || (yNeighborBlock < 0) || (yNeighborBlock >= levelHeightBlocks)) continue;
+				
+				neighborBlockIndex = (yNeighborBlock * levelWidthBlocks) + xNeighborBlock;
+				if ((_blocksParentIndexes[neighborBlockIndex] != -1) || !_isBlockCrossable(xNeighborBlock, yNeighborBlock)) continue;
+				
+				_blocksParentIndexes[neighborBlockIndex] = blockIndex;
+				_blocksQueue.push_back(neighborBlockIndex);
+			}
+		}
+		
+		return -1;
+	}
+
+	/** Tell in which direction the player must shoot to hit a target located on the same row or column, without any wall in between.
+	* @param pointerPlayerRectangle The player position rectangle.
+	* @param pointerTargetRectangle The target position rectangle.
+	* @param pointerDistance On output, contain the distance in pixels separating the player center from the target.
+	* @return The direction to shoot to,
+	* @return -1 if the target can't be hit.
+	*/
+	static int _computeShootingDirection(SDL_Rect *pointerPlayerRectangle, SDL_Rect *pointerTargetRectangle, int *pointerDistance)
+	{
+		int playerCenterX = pointerPlayerRectangle->x + (pointerPlayerRectangle->w / 2);
+		int playerCenterY = pointerPlayerRectangle->y + (pointerPlayerRectangle->h / 2);
+		int targetRightX = pointerTargetRectangle->x + pointerTargetRectangle->w;
+		int targetBottomY = pointerTargetRectangle->y + pointerTargetRectangle->h;
+		
+		// Is the target on the same column ?
+		if ((playerCenterX >= pointerTargetRectangle->x) && (playerCenterX < targetRightX))
+		{
+			// Target is upper
+			if (targetBottomY <= playerCenterY)
+			{
+				*pointerDistance = playerCenterY - targetBottomY;
+				if ((*pointerDistance > CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE) || LevelManager::isObstaclePresentOnVerticalAxis(targetBottomY, playerCenterY, playerCenterX)) return -1;
+				return MovingEntity::DIRECTION_UP;
+			}
+			// Target is downer
+			if (pointerTargetRectangle->y > playerCenterY)
+			{
+				*pointerDistance = pointerTargetRectangle->y - playerCenterY;
+				if ((*pointerDistance > CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE) || LevelManager::isObstaclePresentOnVerticalAxis(playerCenterY, pointerTargetRectangle->y, playerCenterX)) return -1;
+				return MovingEntity::DIRECTION_DOWN;
+			}
+		}
+		// Is the target on the same row ?
+		else if ((playerCenterY >= pointerTargetRectangle->y) && (playerCenterY < targetBottomY))
+		{
+			// Target is on the left
+			if (targetRightX <= playerCenterX)
+			{
+				*pointerDistance = playerCenterX - targetRightX;
+				if ((*pointerDistance > CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE) || LevelManager::isObstaclePresentOnHorizontalAxis(targetRightX, playerCenterX, playerCenterY)) return -1;
+				return MovingEntity::DIRECTION_LEFT;
+			}
+			// Target is on the right
+			if (pointerTargetRectangle->x > playerCenterX)
+			{
+				*pointerDistance = pointerTargetRectangle->x - playerCenterX;
+				if ((*pointerDistance > CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE) || LevelManager::isObstaclePresentOnHorizontalAxis(playerCenterX, pointerTargetRectangle->x, playerCenterY)) return -1;
+				return MovingEntity::DIRECTION_RIGHT;
+			}
+		}
+		
+		return -1;
+	}
+
+	/** Press the key that makes the player go or shoot in a direction.
+	* @param direction The direction.
+	* @return A bit field formatted like ControlManager::getGameplayKeysState() result.
+	*/
+	static inline unsigned int _pressDirectionKey(int direction)
+	{
+		unsigned int keysState = 1 << DIRECTION_KEY_IDS[direction];
+		
+		if ((direction == MovingEntity::DIRECTION_UP) || (direction == MovingEntity::DIRECTION_DOWN)) keysState |= 1 << ControlManager::KEY_ID_PAUSE_GAME; // Tell that the last pressed direction key is vertical
+		return keysState;
+	}
+
+	unsigned int computeGameplayKeysState(std::list<EnemyFightingEntity *> *pointerEnemiesList)
+	{
+		SDL_Rect *pointerPlayerRectangle = pointerPlayer->getPositionRectangle();
+		int direction, distance, shootingDirection = -1, shootingDistance = CONFIGURATION_BOT_MAXIMUM_SHOOTING_DISTANCE + 1;
+		bool isEnemySpawnerShot = false;
+		
+		// Shoot the nearest enemy that can be hit
+		std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+		for (enemiesListIterator = pointerEnemiesList->begin(); enemiesListIterator != pointerEnemiesList->end(); ++enemiesListIterator)
+		{
+			direction = _computeShootingDirection(pointerPlayerRectangle, (*enemiesListIterator)->getPositionRectangle(), &distance);
+			if ((direction != -1) && (distance < shootingDistance))
+			{
+				shootingDirection = direction;
+				shootingDistance = distance;
+			}
+		}
+		// Enemies are more dangerous than enemy spawners, shoot a spawner only when no enemy can be hit
+		if (shootingDirection == -1)
+		{
+			std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+			for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
+			{
+				direction = _computeShootingDirection(pointerPlayerRectangle, (*enemySpawnersListIterator)->getPositionRectangle(), &distance);
+				if ((direction != -1) && (distance < shootingDistance))
+				{
+					shootingDirection = direction;
+					shootingDistance = distance;
+					isEnemySpawnerShot = true;
+				}
+			}
+		}
+		if (shootingDirection != -1)
+		{
+			// Face the target and fire, use the mortar against enemy spawners as they are hard to destroy
+			if (isEnemySpawnerShot) return _pressDirectionKey(shootingDirection) | (1 << ControlManager::KEY_ID_PRIMARY_SHOOT) | (1 << ControlManager::KEY_ID_SECONDARY_SHOOT);
+			return _pressDirectionKey(shootingDirection) | (1 << ControlManager::KEY_ID_PRIMARY_SHOOT);
+		}
+		
+		// Find the block the player is on
+		int playerCenterX = pointerPlayerRectangle->x + (pointerPlayerRectangle->w / 2);
+		int playerCenterY = pointerPlayerRectangle->y + (pointerPlayerRectangle->h / 2);
+		int levelWidthBlocks = LevelManager::getLevelWidthBlocks();
+		int playerBlockIndex = ((playerCenterY / CONFIGURATION_LEVEL_BLOCK_SIZE) * levelWidthBlocks) + (playerCenterX / CONFIGURATION_LEVEL_BLOCK_SIZE);
+		
+		// Compute the route again when the player reaches a new block or when the goals may have moved
+		_routeRemainingTicksCount--;
+		if ((playerBlockIndex != _routeStartingBlockIndex) || (_routeRemainingTicksCount <= 0))
+		{
+			// Always pick up golden medipacks, pick up other items only when they are needed
+			int goalContent = LevelManager::BLOCK_CONTENT_GOLDEN_MEDIPACK;
+			if (pointerPlayer->getLifePointsAmount() * 100 < pointerPlayer->getMaximumLifePointsAmount() * CONFIGURATION_BOT_MEDIPACK_LIFE_POINTS_PERCENTAGE) goalContent |= LevelManager::BLOCK_CONTENT_MEDIPACK;
+			if (pointerPlayer->getAmmunitionAmount() < CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) goalContent |= LevelManager::BLOCK_CONTENT_AMMUNITION;
+			
+			// Destroy the enemy spawners first, then hunt the remaining enemies and finally go to the level exit
+			bool isEnemySpawnerTargeted = !LevelManager::enemySpawnersList.empty();
+			if (!isEnemySpawnerTargeted)
+			{
+				if (!pointerEnemiesList->empty()) goalContent |= LevelManager::BLOCK_CONTENT_ENEMY;
+				else goalContent |= LevelManager::BLOCK_CONTENT_LEVEL_EXIT;
+			}
+			
+			_nextBlockIndex = _computeNextBlockIndex(playerBlockIndex, goalContent, isEnemySpawnerTargeted);
+			_routeStartingBlockIndex = playerBlockIndex;
+			_routeRemainingTicksCount = CONFIGURATION_BOT_ROUTE_REFRESHING_PERIOD;
+		}
+		
+		// Nothing to do
+		if (_nextBlockIndex == -1) return 0;
+		
+		// Compute the player coordinates that fully fit into the next block
+		int blockX = (_nextBlockIndex % levelWidthBlocks) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int blockY = (_nextBlockIndex / levelWidthBlocks) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int distanceX = blockX + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerPlayerRectangle->w) / 2) - pointerPlayerRectangle->x;
+		int distanceY = blockY + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerPlayerRectangle->h) / 2) - pointerPlayerRectangle->y;
+		
+		// The goal is reached, stay at the block center so the targets located on the same row or column can be shot
+		if (_nextBlockIndex == playerBlockIndex)
+		{
+			if (abs(distanceX) > CONFIGURATION_BOT_POSITION_TOLERANCE) return _pressDirectionKey(distanceX < 0 ? MovingEntity::DIRECTION_LEFT : MovingEntity::DIRECTION_RIGHT);
+			if (abs(distanceY) > CONFIGURATION_BOT_POSITION_TOLERANCE) return _pressDirectionKey(distanceY < 0 ? MovingEntity::DIRECTION_UP : MovingEntity::DIRECTION_DOWN);
+			return 0;
+		}
+		
+		// Going to a block on the same row needs the player to be fully contained in the row, otherwise it would be stuck on a wall corner
+		if ((_nextBlockIndex / levelWidthBlocks) == (playerBlockIndex / levelWidthBlocks))
+		{
+			if (pointerPlayerRectangle->y < blockY) return _pressDirectionKey(MovingEntity::DIRECTION_DOWN);
+			if (pointerPlayerRectangle->y + pointerPlayerRectangle->h > blockY + CONFIGURATION_LEVEL_BLOCK_SIZE) return _pressDirectionKey(MovingEntity::DIRECTION_UP);
+			return _pressDirectionKey(distanceX < 0 ? MovingEntity::DIRECTION_LEFT : MovingEntity::DIRECTION_RIGHT);
+		}
+		
+		// Going to a block on the same column needs the player to be fully contained in the column
+		if (pointerPlayerRectangle->x < blockX) return _pressDirectionKey(MovingEntity::DIRECTION_RIGHT);
+		if (pointerPlayerRectangle->x + pointerPlayerRectangle->w > blockX + CONFIGURATION_LEVEL_BLOCK_SIZE) return _pressDirectionKey(MovingEntity::DIRECTION_LEFT);
+		return _pressDirectionKey(distanceY < 0 ? MovingEntity::DIRECTION_UP : MovingEntity::DIRECTION_DOWN);
+	}
+
+	void saveState(Snapshot *pointerSnapshot)
+	{
+		pointerSnapshot->writeInteger(_routeStartingBlockIndex);
+		pointerSnapshot->writeInteger(_nextBlockIndex);
+		pointerSnapshot->writeInteger(_routeRemainingTicksCount);
+	}
+
+	void restoreState(Snapshot *pointerSnapshot)
+	{
+		_routeStartingBlockIndex = pointerSnapshot->readInteger();
+		_nextBlockIndex = pointerSnapshot->readInteger();
+		_routeRemainingTicksCount = pointerSnapshot->readInteger();
+	}
+}
@@ -3,16 +3,27 @@
  * @author Adrien RICCIARDI
  */
 #include <BulletMovingEntity.hpp>
+#include <CollisionManager.hpp>
+#include <Configuration.hpp>
+#include <cstdlib>
 #include <LevelManager.hpp>
 #include <Renderer.hpp>
 #include <TextureManager.hpp>
 
+/** The closest targets of the homing bullet being updated, kept allocated from one bullet to another. */
+static thread_local std::vector<CollisionManager::QueryResult> &_homingTargets = *new std::vector<CollisionManager::QueryResult>();
+
 BulletMovingEntity::BulletMovingEntity(int x, int y, TextureManager::TextureId textureId, int movingPixelsAmount, Direction facingDirection, int damageAmount, bool isEnemySpawnerDamageable): MovingEntity(x, y, textureId, movingPixelsAmount)
 {
+	_textureId = textureId;
 	_range = 2 * Renderer::displayWidth;
 	_facingDirection = facingDirection;
 	_movedDistance = 0;
 	_damageAmount = -damageAmount;
+	_splashRadius = 0;
+	_splashDamageAmount = 0;
+	_isHoming = false;
+	_sweptRectangle = _positionRectangles[_facingDirection];
 	
 	// Collide with enemy spawners when bullet is shot by an enemy, so the bullet can't damage the spawner
 	if (isEnemySpawnerDamageable) _collisionBlockContent &= ~LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER; // Do not collide with enemy spawners to allow bullets enter the enemy spawner position rectangle, so it can be damaged
@@ -26,11 +37,54 @@ int BulletMovingEntity::getDamageAmount()
 	return _damageAmount;
 }
 
+void BulletMovingEntity::enableSplashDamage(int radius, int damageAmount)
+{
+	_splashRadius = radius;
+	_splashDamageAmount = -damageAmount;
+}
+
+void BulletMovingEntity::enableHoming()
+{
+	_isHoming = true;
+}
+
 int BulletMovingEntity::update()
 {
+	SDL_Rect previousPositionRectangle = _positionRectangles[_facingDirection];
+	
+	// Head to the closest target along the axis it is the furthest on, bullets can only move in four directions
+	if (_isHoming)
+	{
+		SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
+		int centerX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
+		int centerY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+		
+		CollisionManager::queryNearest(centerX, centerY, CONFIGURATION_GAMEPLAY_HOMING_ROCKET_DETECTION_RADIUS, COLLISION_MANAGER_LAYER_BIT(CollisionManager::LAYER_ENEMY) | COLLISION_MANAGER_LAYER_BIT(CollisionManager::LAYER_ENEMY_SPAWNER), 1, &_homingTargets);
+		if (!_homingTargets.empty())
+		{
+			SDL_Rect *pointerTargetRectangle = _homingTargets[0].pointerEntity->getPositionRectangle();
+			int distanceX = pointerTargetRectangle->x + (pointerTargetRectangle->w / 2) - centerX;
+			int distanceY = pointerTargetRectangle->y + (pointerTargetRectangle->h / 2) - centerY;
+			
+			if (abs(distanceX) > abs(distanceY))
+			{
+				if (distanceX < 0) _facingDirection = DIRECTION_LEFT;
+				else _facingDirection = DIRECTION_RIGHT;
+			}
+			else
+			{
+				if (distanceY < 0) _facingDirection = DIRECTION_UP;
+				else _facingDirection = DIRECTION_DOWN;
+			}
+		}
+	}
+	
 	// Update position
 	int movedPixelsCount = move(_facingDirection);
 	
+	// Bullets move in straight lines, so the area between both positions is the smallest rectangle containing them (it is slightly bigger when a homing bullet turned)
+	SDL_UnionRect(&previousPositionRectangle, &_positionRectangles[_facingDirection], &_sweptRectangle);
+	
 	// Did the bullet really moved ?
 	if (movedPixelsCount == 0) return 1; // It did not move, so it has hit a wall
 	
@@ -40,3 +94,27 @@ int BulletMovingEntity::update()
 	
 	return 0;
 }
+
+void BulletMovingEntity::saveState(Snapshot *pointerSnapshot)
+{
+	MovingEntity::saveState(pointerSnapshot);
+	
+	pointerSnapshot->writeInteger(_range);
+	pointerSnapshot->writeInteger(_movedDistance);
+	pointerSnapshot->writeInteger(_damageAmount);
+	pointerSnapshot->writeInteger(_splashRadius);
+	pointerSnapshot->writeInteger(_splashDamageAmount);
+	pointerSnapshot->writeInteger(_isHoming);
+}
+
+void BulletMovingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	MovingEntity::restoreState(pointerSnapshot);
+	
+	_range = pointerSnapshot->readInteger();
+	_movedDistance = pointerSnapshot->readInteger();
+	_damageAmount = pointerSnapshot->readInteger();
+	_splashRadius = pointerSnapshot->readInteger();
+	_splashDamageAmount = pointerSnapshot->readInteger();
+	_isHoming = pointerSnapshot->readInteger();
+}
@@ -0,0 +1,212 @@
+/** @file CollisionManager.cpp
+ * See CollisionManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <algorithm>
+#include <CollisionManager.hpp>
+#include <Configuration.hpp>
+#include <EnemySpawnerStaticEntity.hpp>
+#include <LevelManager.hpp>
+#include <PlayerFightingEntity.hpp>
+
+namespace CollisionManager
+{
+	/** The layers each layer collides with. */
+	static const unsigned int LAYERS_COLLISION_MASKS[LAYERS_COUNT] =
+	{
+		COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY) | COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY_SPAWNER), // LAYER_PLAYER_PROJECTILE
+		COLLISION_MANAGER_LAYER_BIT(LAYER_PLAYER), // LAYER_ENEMY_PROJECTILE
+		0, // LAYER_ENEMY
+		0, // LAYER_ENEMY_SPAWNER
+		0 // LAYER_PLAYER
+	};
+
+	/** The enemies overlapped by the projectile being checked, kept allocated from one projectile to another. */
+	static thread_local std::vector<EnemyFightingEntity *> &_collidingEnemies = *new std::vector<EnemyFightingEntity *>();
+	/** The enemy spawners overlapped by the area being queried, kept allocated from one query to another. */
+	static thread_local std::vector<EnemySpawnerStaticEntity *> &_collidingEnemySpawners = *new std::vector<EnemySpawnerStaticEntity *>();
+
+	/** Compute the squared distance between a point and the closest point of a rectangle.
+	 * @param x The point X coordinate in pixels.
+	 * @param y The point Y coordinate in pixels.
+	 * @param pointerRectangle The rectangle.
+	 * @return 0 if the point is inside the rectangle,
+	 * @return the squared distance in pixels.
+	 */
+	static inline int _computeSquaredDistance(int x, int y, SDL_Rect *pointerRectangle)
+	{
+		int distanceX = 0, distanceY = 0;
+		
+		if (x < pointerRectangle->x) distanceX = pointerRectangle->x - x;
+		else if (x >= pointerRectangle->x + pointerRectangle->w) distanceX = x - (pointerRectangle->x + pointerRectangle->w - 1);
+		if (y < pointerRectangle->y) distanceY = pointerRectangle->y - y;
+		else if (y >= pointerRectangle->y + pointerRectangle->h) distanceY = y - (pointerRectangle->y + pointerRectangle->h - 1);
+		
+		return (distanceX * distanceX) + (distanceY * distanceY);
+	}
+
+	/** Add an entity to query results if it is close enough to the query point.
+	 * @param x The query point X coordinate in pixels.
+	 * @param y The query point Y coordinate in pixels.
+	 * @param squaredRadius The squared query radius.
+	 * @param layer The entity layer.
+	 * @param pointerEntity The entity.
+	 * @param pointerPositionRectangle The entity position rectangle.
+	 * @param pointerResults The results to append the entity to.
+	 */
+	static inline void _addQueryResult(int x, int y, int squaredRadius, Layer layer, Entity *pointerEntity, SDL_Rect *pointerPositionRectangle, std::vector<QueryResult> *pointerResults)
+	{
+		QueryResult result;
+		
+		result.squaredDistance = _computeSquaredDistance(x, y, pointerPositionRectangle);
+		if (result.squaredDistance > squaredRadius) return;
+		
+		result.layer = layer;
+		result.pointerEntity = pointerEntity;
+		pointerResults->push_back(result);
+	}
+
+	/** Order query results from the closest to the furthest. Ties are broken with the entities coordinates and layer, so the order never depends on the entities memory addresses.
+	 * @param firstResult The first result to compare.
+	 * @param secondResult The second result to compare.
+	 * @return true if the first result must be placed before the second one,
+	 * @return false otherwise.
+	 */
+	static bool _isQueryResultCloser(const QueryResult &firstResult, const QueryResult &secondResult)
+	{
+		if (firstResult.squaredDistance != secondResult.squaredDistance) return firstResult.squaredDistance < secondResult.squaredDistance;
+		if (firstResult.pointerEntity->getY() != secondResult.pointerEntity->getY()) return firstResult.pointerEntity->getY() < secondResult.pointerEntity->getY();
+		if (firstResult.pointerEntity->getX() != secondResult.pointerEntity->getX()) return firstResult.pointerEntity->getX() < secondResult.pointerEntity->getX();
+		return firstResult.layer < secondResult.layer;
+	}
+
+	/** Find the enemy hit by a projectile.
+	 * @param pointerProjectileRectangle The projectile position rectangle.
+	 * @return NULL if no enemy is hit,
+	 * @return the overlapped enemy coming first in the enemies list.
+	 */
+	static EnemyFightingEntity *_findCollidingEnemy(SDL_Rect *pointerProjectileRectangle)
+	{
+		EnemyFightingEntity *pointerCollidingEnemy;
+		unsigned int i;
+		
+		// Only the enemies located on the blocks the projectile overlaps can be hit
+		_collidingEnemies.clear();
+		LevelManager::getEnemiesCollidingWithRectangle(pointerProjectileRectangle, &_collidingEnemies);
+		if (_collidingEnemies.empty()) return NULL;
+		
+		// When the projectile hits several enemies at once, keep the first one of the enemies list, which has the smallest update order
+		pointerCollidingEnemy = _collidingEnemies[0];
+		for (i = 1; i < _collidingEnemies.size(); i++)
+		{
+			if (_collidingEnemies[i]->getUpdateOrder() < pointerCollidingEnemy->getUpdateOrder()) pointerCollidingEnemy = _collidingEnemies[i];
+		}
+		return pointerCollidingEnemy;
+	}
+
+	void findContacts(Layer projectilesLayer, RectanglesBatch *pointerProjectilesRectangles, std::vector<Contact> *pointerContacts)
+	{
+		unsigned int collisionMask = LAYERS_COLLISION_MASKS[projectilesLayer];
+		int i, projectilesCount = pointerProjectilesRectangles->getCount(), playerHittingProjectileIndex = -1;
+		SDL_Rect projectileRectangle, *pointerPlayerRectangle = pointerPlayer->getPositionRectangle();
+		Contact contact;
+		Entity *pointerEntity;
+		bool isPlayerHit;
+		
+		pointerContacts->clear();
+		
+		// The player is a single rectangle, so test it against all projectiles at once
+		if (collisionMask & COLLISION_MANAGER_LAYER_BIT(LAYER_PLAYER)) playerHittingProjectileIndex = pointerProjectilesRectangles->findFirstIntersection(pointerPlayerRectangle, 0);
+		
+		for (i = 0; i < projectilesCount; i++)
+		{
+			pointerProjectilesRectangles->get(i, &projectileRectangle);
+			contact.projectileIndex = i;
+			
+			// Find the next projectile hitting the player now, in case this one hits something else first
+			isPlayerHit = (i == playerHittingProjectileIndex);
+			if (isPlayerHit) playerHittingProjectileIndex = pointerProjectilesRectangles->findFirstIntersection(pointerPlayerRectangle, i + 1);
+			
+			// Look at the layers in their priority order
+			if (collisionMask & COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY))
+			{
+				pointerEntity = _findCollidingEnemy(&projectileRectangle);
+				if (pointerEntity != NULL)
+				{
+					contact.layer = LAYER_ENEMY;
+					contact.pointerEntity = pointerEntity;
+					pointerContacts->push_back(contact);
+					continue;
+				}
+			}
+			
+			// Spawners are static, so only look at the blocks the projectile overlaps
+			if (collisionMask & COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY_SPAWNER))
+			{
+				pointerEntity = LevelManager::getEnemySpawnerCollidingWithRectangle(&projectileRectangle);
+				if (pointerEntity != NULL)
+				{
+					contact.layer = LAYER_ENEMY_SPAWNER;
+					contact.pointerEntity = pointerEntity;
+					pointerContacts->push_back(contact);
+					continue;
+				}
+			}
+			
+			if (isPlayerHit)
+			{
+				contact.layer = LAYER_PLAYER;
+				contact.pointerEntity = pointerPlayer;
+				pointerContacts->push_back(contact);
+			}
+		}
+	}
+
+	void queryRadius(int x, int y, int radius, unsigned int layersMask, std::vector<QueryResult> *pointerResults)
+	{
+		SDL_Rect boundingRectangle;
+		int squaredRadius = radius * radius;
+		unsigned int i;
+		
+		pointerResults->clear();
+		
+		// Retrieve the entities overlapping the circle bounding box from the blocks indexes, then keep the ones overlapping the circle
+		boundingRectangle.x = x - radius;
+		boundingRectangle.y = y - radius;
+		boundingRectangle.w = (2 * radius) + 1;
+		boundingRectangle.h = (2 * radius) + 1;
+		
+		if (layersMask & COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY))
+		{
+			_collidingEnemies.clear();
+			LevelManager::getEnemiesCollidingWithRectangle(&boundingRectangle, &_collidingEnemies);
+			for (i = 0; i < _collidingEnemies.size(); i++) _addQueryResult(x, y, squaredRadius, LAYER_ENEMY, _collidingEnemies[i], _collidingEnemies[i]->getPositionRectangle(), pointerResults);
+		}
+		
+		if (layersMask & COLLISION_MANAGER_LAYER_BIT(LAYER_ENEMY_SPAWNER))
+		{
+			_collidingEnemySpawners.clear();
+			LevelManager::getEnemySpawnersCollidingWithRectangle(&boundingRectangle, &_collidingEnemySpawners);
+			for (i = 0; i < _collidingEnemySpawners.size(); i++) _addQueryResult(x, y, squaredRadius, LAYER_ENEMY_SPAWNER, _collidingEnemySpawners[i], _collidingEnemySpawners[i]->getPositionRectangle(), pointerResults);
+		}
+		
+		if (layersMask & COLLISION_MANAGER_LAYER_BIT(LAYER_PLAYER)) _addQueryResult(x, y, squaredRadius, LAYER_PLAYER, pointerPlayer, pointerPlayer->getPositionRectangle(), pointerResults);
+	}
+
+	void queryNearest(int x, int y, int maximumDistance, unsigned int layersMask, int count, std::vector<QueryResult> *pointerResults)
+	{
+		int radius = CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Grow the searched area until it contains enough entities, the closest ones are necessarily inside it
+		while (true)
+		{
+			if (radius > maximumDistance) radius = maximumDistance;
+			queryRadius(x, y, radius, layersMask, pointerResults);
+			if (((int) pointerResults->size() >= count) || (radius == maximumDistance)) break;
+			radius *= 2;
+		}
+		
+		std::sort(pointerResults->begin(), pointerResults->end(), _isQueryResultCloser);
+		if ((int) pointerResults->size() > count) pointerResults->resize(count);
+	}
+}
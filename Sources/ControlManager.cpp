@@ -9,10 +9,10 @@
 
 namespace ControlManager
 {
-	/** Hold all keys state. */
-	static bool _isKeyPressed[KEY_IDS_COUNT] = { false };
+	/** Hold all keys state (each simulation thread controls its own player). */
+	static thread_local bool _isKeyPressed[KEY_IDS_COUNT] = { false };
 	/** Tell if the last pressed direction key was on the vertical or the horizontal axis. */
-	static bool _isLastPressedDirectionKeyOnVerticalAxis = false;
+	static thread_local bool _isLastPressedDirectionKeyOnVerticalAxis = false;
 
 	/** The detected game controller. */
 	static SDL_GameController *_pointerGameController = NULL;
@@ -266,4 +266,24 @@ namespace ControlManager
 	{
 		return _isLastPressedDirectionKeyOnVerticalAxis;
 	}
+
+	unsigned int getGameplayKeysState()
+	{
+		unsigned int keysState = 0;
+		
+		// Gameplay keys are the first ones of the enumeration
+		for (int i = 0; i < KEY_ID_PAUSE_GAME; i++)
+		{
+			if (_isKeyPressed[i]) keysState |= 1 << i;
+		}
+		if (_isLastPressedDirectionKeyOnVerticalAxis) keysState |= 1 << KEY_ID_PAUSE_GAME;
+		
+		return keysState;
+	}
+
+	void setGameplayKeysState(unsigned int keysState)
+	{
+		for (int i = 0; i < KEY_ID_PAUSE_GAME; i++) _isKeyPressed[i] = (keysState & (1 << i)) != 0;
+		_isLastPressedDirectionKeyOnVerticalAxis = (keysState & (1 << KEY_ID_PAUSE_GAME)) != 0;
+	}
 }
@@ -19,6 +19,13 @@ namespace EffectManager
 		AudioManager::SoundId soundId; //!< The sound to play.
 	} Effect;
 
+	/** An effect being displayed. */
+	typedef struct
+	{
+		AnimatedTextureStaticEntity *pointerAnimatedTextureStaticEntity; //!< The effect animation.
+		EffectId effectId; //!< The effect, which is needed to create the same animation again when restoring a snapshot.
+	} PlayingEffect;
+
 	/** Cache all effect parameters. */
 	static Effect effects[EFFECT_IDS_COUNT] =
 	{
@@ -169,8 +176,8 @@ namespace EffectManager
 		}
 	};
 
-	/** All animated textures. */
-	static std::list<AnimatedTextureStaticEntity *> _animatedTexturesList;
+	/** All playing effects of the calling thread world. */
+	static thread_local std::list<PlayingEffect> &_playingEffectsList = *new std::list<PlayingEffect>(); // Never destroyed, so it is still available to the exit handlers
 
 	int getEffectTextureWidth(EffectId effectId)
 	{
@@ -197,7 +204,10 @@ namespace EffectManager
 		Effect *pointerEffect = &effects[effectId];
 		
 		// Generate the graphic effect
-		_animatedTexturesList.push_front(new AnimatedTextureStaticEntity(x, y, TextureManager::createAnimatedTextureFromId(pointerEffect->textureId, false)));
+		PlayingEffect playingEffect;
+		playingEffect.pointerAnimatedTextureStaticEntity = new AnimatedTextureStaticEntity(x, y, TextureManager::createAnimatedTextureFromId(pointerEffect->textureId, false));
+		playingEffect.effectId = effectId;
+		_playingEffectsList.push_front(playingEffect);
 		
 		// Play audio effect
 		AudioManager::playSound(pointerEffect->soundId);
@@ -205,33 +215,72 @@ namespace EffectManager
 
 	void clearAllEffects()
 	{
-		std::list<AnimatedTextureStaticEntity *>::iterator animatedTexturesListIterator;
-		for (animatedTexturesListIterator = _animatedTexturesList.begin(); animatedTexturesListIterator != _animatedTexturesList.end(); ++animatedTexturesListIterator) delete *animatedTexturesListIterator;
-		_animatedTexturesList.clear();
+		std::list<PlayingEffect>::iterator playingEffectsListIterator;
+		for (playingEffectsListIterator = _playingEffectsList.begin(); playingEffectsListIterator != _playingEffectsList.end(); ++playingEffectsListIterator) delete playingEffectsListIterator->pointerAnimatedTextureStaticEntity;
+		_playingEffectsList.clear();
 	}
 
 	void update()
 	{
-		std::list<AnimatedTextureStaticEntity *>::iterator animatedTexturesListIterator = _animatedTexturesList.begin();
+		std::list<PlayingEffect>::iterator playingEffectsListIterator = _playingEffectsList.begin();
 		AnimatedTextureStaticEntity *pointerAnimatedTextureStaticEntity;
-		while (animatedTexturesListIterator != _animatedTexturesList.end())
+		while (playingEffectsListIterator != _playingEffectsList.end())
 		{
-			pointerAnimatedTextureStaticEntity = *animatedTexturesListIterator;
+			pointerAnimatedTextureStaticEntity = playingEffectsListIterator->pointerAnimatedTextureStaticEntity;
 			
 			if (pointerAnimatedTextureStaticEntity->update() != 0)
 			{
 				// Remove the texture
 				delete pointerAnimatedTextureStaticEntity;
-				animatedTexturesListIterator = _animatedTexturesList.erase(animatedTexturesListIterator);
+				playingEffectsListIterator = _playingEffectsList.erase(playingEffectsListIterator);
 			}
 			// Animation is not finished, check next one
-			else ++animatedTexturesListIterator;
+			else ++playingEffectsListIterator;
 		}
 	}
 
 	void render()
 	{
-		std::list<AnimatedTextureStaticEntity *>::iterator animatedTexturesListIterator;
-		for (animatedTexturesListIterator = _animatedTexturesList.begin(); animatedTexturesListIterator != _animatedTexturesList.end(); ++animatedTexturesListIterator) (*animatedTexturesListIterator)->render();
+		std::list<PlayingEffect>::iterator playingEffectsListIterator;
+		for (playingEffectsListIterator = _playingEffectsList.begin(); playingEffectsListIterator != _playingEffectsList.end(); ++playingEffectsListIterator) playingEffectsListIterator->pointerAnimatedTextureStaticEntity->render();
+	}
+
+	void saveState(Snapshot *pointerSnapshot)
+	{
+		std::list<PlayingEffect>::iterator playingEffectsListIterator;
+		
+		pointerSnapshot->writeInteger(_playingEffectsList.size());
+		for (playingEffectsListIterator = _playingEffectsList.begin(); playingEffectsListIterator != _playingEffectsList.end(); ++playingEffectsListIterator)
+		{
+			pointerSnapshot->writeInteger(playingEffectsListIterator->effectId);
+			playingEffectsListIterator->pointerAnimatedTextureStaticEntity->saveState(pointerSnapshot);
+		}
+	}
+
+	int restoreState(Snapshot *pointerSnapshot)
+	{
+		PlayingEffect playingEffect;
+		int i, effectsCount, effectId;
+		
+		clearAllEffects();
+		
+		// Create the animations again, but do not play their sound as they are already started
+		effectsCount = pointerSnapshot->readInteger();
+		for (i = 0; (i < effectsCount) && !pointerSnapshot->isReadingFailed(); i++)
+		{
+			effectId = pointerSnapshot->readInteger();
+			if ((effectId < 0) || (effectId >= EFFECT_IDS_COUNT))
+			{
+				LOG_ERROR("Snapshot effect %d ID is bad : %d.", i, effectId);
+				return -1;
+			}
+			
+			playingEffect.pointerAnimatedTextureStaticEntity = new AnimatedTextureStaticEntity(0, 0, TextureManager::createAnimatedTextureFromId(effects[effectId].textureId, false));
+			playingEffect.pointerAnimatedTextureStaticEntity->restoreState(pointerSnapshot);
+			playingEffect.effectId = (EffectId) effectId;
+			_playingEffectsList.push_back(playingEffect);
+		}
+		
+		return 0;
 	}
 }
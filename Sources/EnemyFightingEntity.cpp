@@ -10,7 +10,9 @@
 #include <EnemyFightingEntity.hpp>
 #include <LevelManager.hpp>
 #include <Log.hpp>
+#include <PathfindingManager.hpp>
 #include <PlayerFightingEntity.hpp>
+#include <RandomManager.hpp>
 #include <Renderer.hpp>
 #include <TextureManager.hpp>
 
@@ -19,65 +21,97 @@ EnemyFightingEntity::EnemyFightingEntity(int x, int y, TextureManager::TextureId
 	// Enemies collide between them too
 	_collisionBlockContent |= LevelManager::BLOCK_CONTENT_ENEMY;
 	
-	// Initialize spotting rectangle to around the entity
-	_spottingRectangle.w = Renderer::displayWidth * 2; // Thus, the player staying at on side of the display will be spotted by an enemy located at the display other side
-	_spottingRectangle.h = Renderer::displayHeight * 2;
-	_spottingRectangle.x = _positionRectangles[DIRECTION_UP].x - ((_spottingRectangle.w - _positionRectangles[DIRECTION_UP].w) / 2);
-	_spottingRectangle.y = _positionRectangles[DIRECTION_UP].y - ((_spottingRectangle.h - _positionRectangles[DIRECTION_UP].h) / 2);
-	
 	// Cache effects
 	_explosionEffectId = explosionEffectId;
+	_idleRegionsVersion = 0;
+	_updateOrder = 0;
 	
 	// Get a bullet width
 	Texture *pointerBulletTexture = TextureManager::getTextureFromId(bulletTextureId); // Use textures to avoid instantiate a bullet to get its dimensions
 	int bulletWidth = pointerBulletTexture->getWidth();
 	
-	// Cache all shooting rectangles
+	// Cache all shooting rectangles, in directions order
+	SDL_Rect rectangle;
 	// Up direction
-	_shootingRectangles[DIRECTION_UP].x = _positionRectangles[DIRECTION_UP].x + ((_positionRectangles[DIRECTION_UP].w - bulletWidth) / 2);
-	_shootingRectangles[DIRECTION_UP].y = (_positionRectangles[DIRECTION_UP].y + (_positionRectangles[DIRECTION_UP].h / 2)) - (Renderer::displayHeight / 2);
-	_shootingRectangles[DIRECTION_UP].w = bulletWidth;
-	_shootingRectangles[DIRECTION_UP].h = (Renderer::displayHeight / 2) - (_positionRectangles[DIRECTION_UP].h / 2); // Make the enemy always visible when it starts shooting the player, make the rectangle height end at the beginning of the enemy texture
+	rectangle.x = _positionRectangles[DIRECTION_UP].x + ((_positionRectangles[DIRECTION_UP].w - bulletWidth) / 2);
+	rectangle.y = (_positionRectangles[DIRECTION_UP].y + (_positionRectangles[DIRECTION_UP].h / 2)) - (Renderer::displayHeight / 2);
+	rectangle.w = bulletWidth;
+	rectangle.h = (Renderer::displayHeight / 2) - (_positionRectangles[DIRECTION_UP].h / 2); // Make the enemy always visible when it starts shooting the player, make the rectangle height end at the beginning of the enemy texture
+	_sightRectangles.add(&rectangle);
 	// Down direction
-	_shootingRectangles[DIRECTION_DOWN].x = _positionRectangles[DIRECTION_UP].x + ((_positionRectangles[DIRECTION_UP].w - bulletWidth) / 2);
-	_shootingRectangles[DIRECTION_DOWN].y = _positionRectangles[DIRECTION_UP].y + _positionRectangles[DIRECTION_UP].h;
-	_shootingRectangles[DIRECTION_DOWN].w = bulletWidth;
-	_shootingRectangles[DIRECTION_DOWN].h = (Renderer::displayHeight / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
+	rectangle.x = _positionRectangles[DIRECTION_UP].x + ((_positionRectangles[DIRECTION_UP].w - bulletWidth) / 2);
+	rectangle.y = _positionRectangles[DIRECTION_UP].y + _positionRectangles[DIRECTION_UP].h;
+	rectangle.w = bulletWidth;
+	rectangle.h = (Renderer::displayHeight / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
+	_sightRectangles.add(&rectangle);
 	// Left direction
-	_shootingRectangles[DIRECTION_LEFT].x = _positionRectangles[DIRECTION_UP].x + (_positionRectangles[DIRECTION_UP].w / 2) - (Renderer::displayWidth / 2);
-	_shootingRectangles[DIRECTION_LEFT].y = _positionRectangles[DIRECTION_UP].y + ((_positionRectangles[DIRECTION_UP].h - bulletWidth) / 2);
-	_shootingRectangles[DIRECTION_LEFT].w = (Renderer::displayWidth / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
-	_shootingRectangles[DIRECTION_LEFT].h = bulletWidth;
+	rectangle.x = _positionRectangles[DIRECTION_UP].x + (_positionRectangles[DIRECTION_UP].w / 2) - (Renderer::displayWidth / 2);
+	rectangle.y = _positionRectangles[DIRECTION_UP].y + ((_positionRectangles[DIRECTION_UP].h - bulletWidth) / 2);
+	rectangle.w = (Renderer::displayWidth / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
+	rectangle.h = bulletWidth;
+	_sightRectangles.add(&rectangle);
 	// Right direction
-	_shootingRectangles[DIRECTION_RIGHT].x = _positionRectangles[DIRECTION_UP].x + _positionRectangles[DIRECTION_UP].w;
-	_shootingRectangles[DIRECTION_RIGHT].y = _positionRectangles[DIRECTION_UP].y + ((_positionRectangles[DIRECTION_UP].h - bulletWidth) / 2);
-	_shootingRectangles[DIRECTION_RIGHT].w = (Renderer::displayWidth / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
-	_shootingRectangles[DIRECTION_RIGHT].h = bulletWidth;
+	rectangle.x = _positionRectangles[DIRECTION_UP].x + _positionRectangles[DIRECTION_UP].w;
+	rectangle.y = _positionRectangles[DIRECTION_UP].y + ((_positionRectangles[DIRECTION_UP].h - bulletWidth) / 2);
+	rectangle.w = (Renderer::displayWidth / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
+	rectangle.h = bulletWidth;
+	_sightRectangles.add(&rectangle);
+	
+	// Initialize spotting rectangle to around the entity
+	rectangle.w = Renderer::displayWidth * 2; // Thus, the player staying at on side of the display will be spotted by an enemy located at the display other side
+	rectangle.h = Renderer::displayHeight * 2;
+	rectangle.x = _positionRectangles[DIRECTION_UP].x - ((rectangle.w - _positionRectangles[DIRECTION_UP].w) / 2);
+	rectangle.y = _positionRectangles[DIRECTION_UP].y - ((rectangle.h - _positionRectangles[DIRECTION_UP].h) / 2);
+	_sightRectangles.add(&rectangle);
+	_updateShootingLanes();
 	
 	// Set block under enemy center as containing an enemy
+	_isCountedInBlock = false;
 	_setBlockEnemyContent(1);
+	
+	// Make the enemy reachable by the collision tests
+	_indexedRectangle.x = _positionRectangles[DIRECTION_UP].x;
+	_indexedRectangle.y = _positionRectangles[DIRECTION_UP].y;
+	_indexedRectangle.w = 0;
+	_indexedRectangle.h = 0;
+	for (int i = 0; i < DIRECTIONS_COUNT; i++)
+	{
+		if (_positionRectangles[i].w > _indexedRectangle.w) _indexedRectangle.w = _positionRectangles[i].w;
+		if (_positionRectangles[i].h > _indexedRectangle.h) _indexedRectangle.h = _positionRectangles[i].h;
+	}
+	LevelManager::addEnemyToBlocks(this, &_indexedRectangle);
 }
 
-EnemyFightingEntity::~EnemyFightingEntity() {}
+EnemyFightingEntity::~EnemyFightingEntity()
+{
+	_setBlockEnemyContent(0);
+	LevelManager::removeEnemyFromBlocks(this, &_indexedRectangle);
+}
 
 void EnemyFightingEntity::setX(int x)
 {
 	// Adjust shooting rectangles
 	int movedPixelsAmount = x - _positionRectangles[DIRECTION_UP].x; // Compute the amount of pixels that have been moved (i.e. an offset) to avoid to recompute all collision rectangles
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].x += movedPixelsAmount;
+	for (int i = 0; i < DIRECTIONS_COUNT; i++) _sightRectangles.move(i, movedPixelsAmount, 0);
 	
 	// Adjust position rectangles
 	MovingEntity::setX(x);
+	_updateBlocksIndex();
+	_updateShootingLanes();
+	_idleRegionsVersion = 0; // The enemy may have been moved to another region
 }
 
 void EnemyFightingEntity::setY(int y)
 {
 	// Adjust shooting rectangles
 	int movedPixelsAmount = y - _positionRectangles[DIRECTION_UP].y; // Compute the amount of pixels that have been moved (i.e. an offset) to avoid to recompute all collision rectangles
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].y += movedPixelsAmount;
+	for (int i = 0; i < DIRECTIONS_COUNT; i++) _sightRectangles.move(i, 0, movedPixelsAmount);
 	
 	// Adjust position rectangles
 	MovingEntity::setY(y);
+	_updateBlocksIndex();
+	_updateShootingLanes();
+	_idleRegionsVersion = 0; // The enemy may have been moved to another region
 }
 
 int EnemyFightingEntity::moveToUp()
@@ -87,10 +121,11 @@ int EnemyFightingEntity::moveToUp()
 	int movedPixelsAmount = MovingEntity::moveToUp();
 	// Set enemy presence in new block
 	_setBlockEnemyContent(1);
+	_updateBlocksIndex();
 	
 	// Adjust rectangles coordinates to take this move into account
-	_spottingRectangle.y -= movedPixelsAmount;
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].y -= movedPixelsAmount;
+	_sightRectangles.moveAll(0, -movedPixelsAmount);
+	_updateShootingLanes();
 	
 	return movedPixelsAmount;
 }
@@ -102,10 +137,11 @@ int EnemyFightingEntity::moveToDown()
 	int movedPixelsAmount = MovingEntity::moveToDown();
 	// Set enemy presence in new block
 	_setBlockEnemyContent(1);
+	_updateBlocksIndex();
 	
 	// Adjust rectangles coordinates to take this move into account
-	_spottingRectangle.y += movedPixelsAmount;
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].y += movedPixelsAmount;
+	_sightRectangles.moveAll(0, movedPixelsAmount);
+	_updateShootingLanes();
 	
 	return movedPixelsAmount;
 }
@@ -117,10 +153,11 @@ int EnemyFightingEntity::moveToLeft()
 	int movedPixelsAmount = MovingEntity::moveToLeft();
 	// Set enemy presence in new block
 	_setBlockEnemyContent(1);
+	_updateBlocksIndex();
 	
 	// Adjust rectangles coordinates to take this move into account
-	_spottingRectangle.x -= movedPixelsAmount;
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].x -= movedPixelsAmount;
+	_sightRectangles.moveAll(-movedPixelsAmount, 0);
+	_updateShootingLanes();
 	
 	return movedPixelsAmount;
 }
@@ -132,10 +169,11 @@ int EnemyFightingEntity::moveToRight()
 	int movedPixelsAmount = MovingEntity::moveToRight();
 	// Set enemy presence in new block
 	_setBlockEnemyContent(1);
+	_updateBlocksIndex();
 	
 	// Adjust rectangles coordinates to take this move into account
-	_spottingRectangle.x += movedPixelsAmount;
-	for (int i = 0; i < DIRECTIONS_COUNT; i++) _shootingRectangles[i].x += movedPixelsAmount;
+	_sightRectangles.moveAll(movedPixelsAmount, 0);
+	_updateShootingLanes();
 	
 	return movedPixelsAmount;
 }
@@ -155,10 +193,29 @@ int EnemyFightingEntity::update()
 	}
 	
 	// Nothing to do if the player is not spotted
-	if (!SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_spottingRectangle)) return 0;
+	SDL_Rect *pointerPlayerRectangle = pointerPlayer->getPositionRectangle();
+	if (_sightRectangles.findFirstIntersection(pointerPlayerRectangle, SPOTTING_RECTANGLE_INDEX) == -1) return 0;
 	
-	// Shoot if the player is at sight
-	if (_isShootPossible()) return 2;
+	// Enemies shoot along the level axes only, so the player can be at sight only when he stands on the block columns or rows the shooting rectangles cross
+	int playerFirstColumn = pointerPlayerRectangle->x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int playerLastColumn = (pointerPlayerRectangle->x + pointerPlayerRectangle->w - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int playerFirstRow = pointerPlayerRectangle->y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int playerLastRow = (pointerPlayerRectangle->y + pointerPlayerRectangle->h - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	if (((playerFirstColumn <= _shootingLaneLastColumn) && (playerLastColumn >= _shootingLaneFirstColumn)) || ((playerFirstRow <= _shootingLaneLastRow) && (playerLastRow >= _shootingLaneFirstRow)))
+	{
+		// Shoot if the player is at sight
+		if (_isShootPossible(_sightRectangles.computeIntersectionsMask(pointerPlayerRectangle))) return 2;
+	}
+	
+	// Do not wander when no path leads to the player, this can change only when the level regions change
+	unsigned int regionsVersion = PathfindingManager::getRegionsVersion();
+	if (_idleRegionsVersion == regionsVersion) return 0;
+	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
+	if (!PathfindingManager::isReachable(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2), pointerPositionRectangle->y + (pointerPositionRectangle->h / 2), pointerPlayerRectangle->x + (pointerPlayerRectangle->w / 2), pointerPlayerRectangle->y + (pointerPlayerRectangle->h / 2)))
+	{
+		_idleRegionsVersion = regionsVersion;
+		return 0;
+	}
 	
 	// If the enemy can't shoot, it must move to come close enough to the player
 	Direction playerDirection;
@@ -168,6 +225,9 @@ int EnemyFightingEntity::update()
 		return 0;
 	}
 	
+	// Walk around the walls toward the player, going straight to the player is kept for the last block
+	_getPathDirection(&playerDirection);
+	
 	// Try to move in the best direction
 	int movedPixelsAmount = move(playerDirection);
 	if (movedPixelsAmount > 0) _isReplacementDirectionChosen = 0; // Enemy can move in its preferred direction, no need to use a replacement one
@@ -178,7 +238,7 @@ int EnemyFightingEntity::update()
 		{
 			do
 			{
-				_replacementDirection = (Direction) (rand() % DIRECTIONS_COUNT);
+				_replacementDirection = (Direction) RandomManager::generateNumber(RandomManager::STREAM_ID_ENEMY_ARTIFICIAL_INTELLIGENCE, DIRECTIONS_COUNT);
 			} while (_replacementDirection == playerDirection);
 		}
 		
@@ -202,48 +262,59 @@ void EnemyFightingEntity::render()
 		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 255, 0, 255);
 		
 		SDL_Rect renderingRectangle;
-		renderingRectangle.x = _spottingRectangle.x - Renderer::displayX;
-		renderingRectangle.y = _spottingRectangle.y - Renderer::displayY;
-		renderingRectangle.w = _spottingRectangle.w;
-		renderingRectangle.h = _spottingRectangle.h;
+		_sightRectangles.get(SPOTTING_RECTANGLE_INDEX, &renderingRectangle);
+		renderingRectangle.x -= Renderer::displayX;
+		renderingRectangle.y -= Renderer::displayY;
 		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
 		
 		// Shooting rectangles
 		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 255, 0, 0, 255);
 		
-		renderingRectangle.x = _shootingRectangles[DIRECTION_UP].x - Renderer::displayX;
-		renderingRectangle.y = _shootingRectangles[DIRECTION_UP].y - Renderer::displayY;
-		renderingRectangle.w = _shootingRectangles[DIRECTION_UP].w;
-		renderingRectangle.h = _shootingRectangles[DIRECTION_UP].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
-		
-		renderingRectangle.x = _shootingRectangles[DIRECTION_DOWN].x - Renderer::displayX;
-		renderingRectangle.y = _shootingRectangles[DIRECTION_DOWN].y - Renderer::displayY;
-		renderingRectangle.w = _shootingRectangles[DIRECTION_DOWN].w;
-		renderingRectangle.h = _shootingRectangles[DIRECTION_DOWN].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
-		
-		renderingRectangle.x = _shootingRectangles[DIRECTION_LEFT].x - Renderer::displayX;
-		renderingRectangle.y = _shootingRectangles[DIRECTION_LEFT].y - Renderer::displayY;
-		renderingRectangle.w = _shootingRectangles[DIRECTION_LEFT].w;
-		renderingRectangle.h = _shootingRectangles[DIRECTION_LEFT].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
-		
-		renderingRectangle.x = _shootingRectangles[DIRECTION_RIGHT].x - Renderer::displayX;
-		renderingRectangle.y = _shootingRectangles[DIRECTION_RIGHT].y - Renderer::displayY;
-		renderingRectangle.w = _shootingRectangles[DIRECTION_RIGHT].w;
-		renderingRectangle.h = _shootingRectangles[DIRECTION_RIGHT].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		for (int i = 0; i < DIRECTIONS_COUNT; i++)
+		{
+			_sightRectangles.get(i, &renderingRectangle);
+			renderingRectangle.x -= Renderer::displayX;
+			renderingRectangle.y -= Renderer::displayY;
+			SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		}
 		
 		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 0, 0, 255);
 	}
 	#endif
 }
 
-int EnemyFightingEntity::_isShootPossible()
+void EnemyFightingEntity::saveState(Snapshot *pointerSnapshot)
+{
+	FightingEntity::saveState(pointerSnapshot);
+	
+	// The spotting rectangle is not moved by the setters, so it is not always centered on the enemy
+	SDL_Rect spottingRectangle;
+	_sightRectangles.get(SPOTTING_RECTANGLE_INDEX, &spottingRectangle);
+	pointerSnapshot->writeInteger(spottingRectangle.x);
+	pointerSnapshot->writeInteger(spottingRectangle.y);
+	pointerSnapshot->writeInteger(_isReplacementDirectionChosen);
+	pointerSnapshot->writeInteger(_replacementDirection);
+}
+
+void EnemyFightingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	// Shooting rectangles are moved with the enemy by the parent class
+	FightingEntity::restoreState(pointerSnapshot);
+	
+	int spottingRectangleX = pointerSnapshot->readInteger();
+	int spottingRectangleY = pointerSnapshot->readInteger();
+	_sightRectangles.setPosition(SPOTTING_RECTANGLE_INDEX, spottingRectangleX, spottingRectangleY);
+	_isReplacementDirectionChosen = pointerSnapshot->readInteger();
+	_replacementDirection = (Direction) pointerSnapshot->readInteger();
+	
+	// Count the enemy at its restored location
+	_setBlockEnemyContent(1);
+}
+
+int EnemyFightingEntity::_isShootPossible(unsigned int sightRectanglesMask)
 {
 	// Is the player in line of sight ?
-	if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_UP]))
+	if (sightRectanglesMask & (1 << DIRECTION_UP))
 	{
 		// Shoot if the enemy is in the right direction
 		if (_facingDirection == DIRECTION_UP)
@@ -252,7 +323,7 @@ int EnemyFightingEntity::_isShootPossible()
 		}
 		else turnToUp(); // Face right direction
 	}
-	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_DOWN]))
+	else if (sightRectanglesMask & (1 << DIRECTION_DOWN))
 	{
 		if (_facingDirection == DIRECTION_DOWN)
 		{
@@ -260,7 +331,7 @@ int EnemyFightingEntity::_isShootPossible()
 		}
 		else turnToDown();
 	}
-	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_LEFT]))
+	else if (sightRectanglesMask & (1 << DIRECTION_LEFT))
 	{
 		if (_facingDirection == DIRECTION_LEFT)
 		{
@@ -268,7 +339,7 @@ int EnemyFightingEntity::_isShootPossible()
 		}
 		else turnToLeft();
 	}
-	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_RIGHT]))
+	else if (sightRectanglesMask & (1 << DIRECTION_RIGHT))
 	{
 		if (_facingDirection == DIRECTION_RIGHT)
 		{
@@ -331,20 +402,85 @@ int EnemyFightingEntity::_getPlayerDirection(Direction *pointerDirection)
 	return 0;
 }
 
+int EnemyFightingEntity::_getPathDirection(Direction *pointerDirection)
+{
+	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
+	int centerX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
+	int centerY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+	SDL_Rect *pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle();
+	Direction direction;
+	
+	// The flow field only covers the blocks close to the player, search the clusters graph when the enemy is further
+	if (!PathfindingManager::getFlowFieldDirection(centerX, centerY, &direction))
+	{
+		if (!PathfindingManager::getPathDirection(centerX, centerY, pointerPlayerPositionRectangle->x + (pointerPlayerPositionRectangle->w / 2), pointerPlayerPositionRectangle->y + (pointerPlayerPositionRectangle->h / 2), &direction)) return 0;
+	}
+	
+	// Going to a block on the same row needs the enemy to be fully contained in the row, otherwise it would be stuck on a wall corner
+	int blockX = (centerX / CONFIGURATION_LEVEL_BLOCK_SIZE) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int blockY = (centerY / CONFIGURATION_LEVEL_BLOCK_SIZE) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+	if ((direction == DIRECTION_LEFT) || (direction == DIRECTION_RIGHT))
+	{
+		if (pointerPositionRectangle->y < blockY) direction = DIRECTION_DOWN;
+		else if (pointerPositionRectangle->y + pointerPositionRectangle->h > blockY + CONFIGURATION_LEVEL_BLOCK_SIZE) direction = DIRECTION_UP;
+	}
+	// Going to a block on the same column needs the enemy to be fully contained in the column
+	else
+	{
+		if (pointerPositionRectangle->x < blockX) direction = DIRECTION_RIGHT;
+		else if (pointerPositionRectangle->x + pointerPositionRectangle->w > blockX + CONFIGURATION_LEVEL_BLOCK_SIZE) direction = DIRECTION_LEFT;
+	}
+	
+	*pointerDirection = direction;
+	return 1;
+}
+
 void EnemyFightingEntity::_setBlockEnemyContent(bool isEnemyPresent)
 {
-	// Cache enemy center coordinates
+	// Leave the block the enemy was counted in
+	if (_isCountedInBlock)
+	{
+		LevelManager::decreaseBlockEnemiesCount(_countedX, _countedY);
+		_isCountedInBlock = false;
+	}
+	if (!isEnemyPresent) return;
+	
+	// Count the enemy in the block under its center
 	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
-	int enemyCenterX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
-	int enemyCenterY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+	_countedX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
+	_countedY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+	LevelManager::increaseBlockEnemiesCount(_countedX, _countedY);
+	_isCountedInBlock = true;
+}
+
+void EnemyFightingEntity::_updateBlocksIndex()
+{
+	int x = _positionRectangles[DIRECTION_UP].x;
+	int y = _positionRectangles[DIRECTION_UP].y;
 	
-	// Get current block content
-	int blockContent = LevelManager::getBlockContent(enemyCenterX, enemyCenterY);
+	// Enemies move a few pixels per tick, so most of the time they stay on the same blocks
+	if ((x / CONFIGURATION_LEVEL_BLOCK_SIZE == _indexedRectangle.x / CONFIGURATION_LEVEL_BLOCK_SIZE) && ((x + _indexedRectangle.w - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE == (_indexedRectangle.x + _indexedRectangle.w - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE) && (y / CONFIGURATION_LEVEL_BLOCK_SIZE == _indexedRectangle.y / CONFIGURATION_LEVEL_BLOCK_SIZE) && ((y + _indexedRectangle.h - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE == (_indexedRectangle.y + _indexedRectangle.h - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE))
+	{
+		_indexedRectangle.x = x;
+		_indexedRectangle.y = y;
+		return;
+	}
 	
-	// Set or reset enemy flag
-	if (isEnemyPresent) blockContent |= LevelManager::BLOCK_CONTENT_ENEMY;
-	else blockContent &= ~LevelManager::BLOCK_CONTENT_ENEMY;
+	LevelManager::removeEnemyFromBlocks(this, &_indexedRectangle);
+	_indexedRectangle.x = x;
+	_indexedRectangle.y = y;
+	LevelManager::addEnemyToBlocks(this, &_indexedRectangle);
+}
+
+void EnemyFightingEntity::_updateShootingLanes()
+{
+	SDL_Rect shootingRectangle;
 	
-	// Set new block content
-	LevelManager::setBlockContent(enemyCenterX, enemyCenterY, blockContent);
+	// Up and down shooting rectangles share the same columns, left and right ones share the same rows
+	_sightRectangles.get(DIRECTION_UP, &shootingRectangle);
+	_shootingLaneFirstColumn = shootingRectangle.x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	_shootingLaneLastColumn = (shootingRectangle.x + shootingRectangle.w - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	_sightRectangles.get(DIRECTION_LEFT, &shootingRectangle);
+	_shootingLaneFirstRow = shootingRectangle.y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	_shootingLaneLastRow = (shootingRectangle.y + shootingRectangle.h - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
 }
@@ -39,5 +39,31 @@ int EnemySpawnerStaticEntity::update()
 	else if (_lifePointsAmount == 4) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_3);
 	else if (_lifePointsAmount == 2) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_4);
 	
+	// Animate teleportation effect
+	_pointerEffectTexture->update();
+	
 	return 0;
 }
+
+void EnemySpawnerStaticEntity::saveState(Snapshot *pointerSnapshot)
+{
+	StaticEntity::saveState(pointerSnapshot);
+	
+	pointerSnapshot->writeInteger(_lifePointsAmount);
+	_pointerEffectTexture->saveState(pointerSnapshot);
+}
+
+void EnemySpawnerStaticEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	StaticEntity::restoreState(pointerSnapshot);
+	
+	_lifePointsAmount = pointerSnapshot->readInteger();
+	_pointerEffectTexture->restoreState(pointerSnapshot);
+	
+	// Show the damage state update() displayed when the spawner reached this life points amount
+	if (_lifePointsAmount <= 2) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_4);
+	else if (_lifePointsAmount <= 4) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_3);
+	else if (_lifePointsAmount <= 6) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_2);
+	else if (_lifePointsAmount <= 8) _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER_DAMAGED_1);
+	else _pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_ENEMY_SPAWNER);
+}
@@ -3,6 +3,7 @@
  * @author Adrien RICCIARDI
  */
 #include <FightingEntity.hpp>
+#include <GameClock.hpp>
 #include <LevelManager.hpp>
 
 FightingEntity::FightingEntity(int x, int y, TextureManager::TextureId textureId, int movingPixelsAmount, int maximumLifePointsAmount, int timeBetweenShots, TextureManager::TextureId facingUpBulletTextureId, EffectManager::EffectId firingEffectId): MovingEntity(x, y, textureId, movingPixelsAmount)
@@ -23,7 +24,7 @@ FightingEntity::FightingEntity(int x, int y, TextureManager::TextureId textureId
 	_computeFiringEffectStartingPositionOffsets(_pointerTextures[DIRECTION_UP], firingEffectId, _firingEffectStartingPositionOffsets);
 	
 	_timeBetweenShots = timeBetweenShots;
-	_lastShotTime = 0; // Allow to shoot immediately
+	_lastShotTime = GameClock::getTime() - timeBetweenShots; // Allow to shoot immediately
 }
 
 FightingEntity::~FightingEntity() {}
@@ -42,7 +43,7 @@ bool FightingEntity::modifyLife(int lifePointsAmount)
 BulletMovingEntity *FightingEntity::shoot()
 {
 	// Allow to shoot only if enough time elapsed since last shot
-	if (SDL_GetTicks() - _lastShotTime >= _timeBetweenShots)
+	if (GameClock::getTime() - _lastShotTime >= _timeBetweenShots)
 	{
 		// Cache entity coordinates
 		int entityX = _positionRectangles[_facingDirection].x;
@@ -61,14 +62,33 @@ BulletMovingEntity *FightingEntity::shoot()
 		EffectManager::EffectId muzzleFlashEffectId = (EffectManager::EffectId) ((int) _firingEffectId + (int) _facingDirection); // Select the right effect according to entity direction
 		EffectManager::addEffect(entityX + firingEffectStartingPositionOffsetX, entityY + firingEffectStartingPositionOffsetY, muzzleFlashEffectId);
 		
-		// Get time after having generated the bullet, in case this takes more than 1 millisecond
-		_lastShotTime = SDL_GetTicks();
+		_lastShotTime = GameClock::getTime();
 		
 		return pointerBullet;
 	}
 	return NULL; // No shot allowed
 }
 
+void FightingEntity::saveState(Snapshot *pointerSnapshot)
+{
+	MovingEntity::saveState(pointerSnapshot);
+	
+	pointerSnapshot->writeInteger(_lifePointsAmount);
+	pointerSnapshot->writeInteger(_maximumLifePointsAmount);
+	pointerSnapshot->writeUnsignedInteger(_lastShotTime);
+	pointerSnapshot->writeUnsignedInteger(_timeBetweenShots);
+}
+
+void FightingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	MovingEntity::restoreState(pointerSnapshot);
+	
+	_lifePointsAmount = pointerSnapshot->readInteger();
+	_maximumLifePointsAmount = pointerSnapshot->readInteger();
+	_lastShotTime = pointerSnapshot->readUnsignedInteger();
+	_timeBetweenShots = pointerSnapshot->readUnsignedInteger();
+}
+
 void FightingEntity::_computeBulletStartingPositionOffsets(Texture *pointerEntityTexture, Texture *pointerFacingUpBulletTexture, SDL_Point *pointerPositionOffsets)
 {
 	// Cache dimensions
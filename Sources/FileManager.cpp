@@ -49,7 +49,7 @@ namespace FileManager
 	const char *getFilePath(const char *pointerStringFileName)
 	{
 		#ifdef CONFIGURATION_BUILD_FOR_MACOS
-			static char stringPath[16384];
+			static thread_local char stringPath[16384]; // Levels can be loaded by multiple threads at the same time
 			
 			// Build the path
 			strcpy(stringPath, stringBasePath); // Base path has always a terminating separator (this is specified by SDL documentation)
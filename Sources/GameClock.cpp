@@ -0,0 +1,100 @@
+/** @file GameClock.cpp
+ * See GameClock.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <cmath>
+#include <Configuration.hpp>
+#include <GameClock.hpp>
+#include <Log.hpp>
+#include <SDL2/SDL.h>
+
+namespace GameClock
+{
+	/** The simulation time in milliseconds (each thread has its own clock). */
+	static thread_local unsigned int _simulationTime = 0;
+
+	/** The real time when ticks to execute were computed for the last time. */
+	static thread_local unsigned int _previousRealTime = 0;
+	/** Scaled real time (in milliseconds) that has not been consumed by game logic ticks yet. */
+	static thread_local float _ticksTimeAccumulator = 0;
+
+	/** Tell whether simulation time is stopped. */
+	static thread_local bool _isPaused = false;
+	/** How fast simulation time runs compared to real time. */
+	static thread_local float _timeScale = 1;
+
+	void initialize()
+	{
+		_simulationTime = 0;
+		_previousRealTime = SDL_GetTicks();
+		_ticksTimeAccumulator = 0;
+	}
+
+	unsigned int getTime()
+	{
+		return _simulationTime;
+	}
+
+	void setTime(unsigned int time)
+	{
+		_simulationTime = time;
+	}
+
+	void tick()
+	{
+		_simulationTime += CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS;
+	}
+
+	int computeTicksToExecuteCount()
+	{
+		// Retrieve elapsed real time
+		unsigned int currentRealTime = SDL_GetTicks();
+		unsigned int elapsedRealTime = currentRealTime - _previousRealTime;
+		_previousRealTime = currentRealTime;
+		
+		if (_isPaused) return 0;
+		
+		// Determine how many ticks fit in the scaled elapsed time
+		_ticksTimeAccumulator += elapsedRealTime * _timeScale;
+		int ticksCount = (int) (_ticksTimeAccumulator / CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS);
+		_ticksTimeAccumulator -= ticksCount * CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS;
+		
+		// Do not try to catch up forever if the computer is too slow, drop the late time and slow down the game instead (the limit grows with the time scale to allow fast forward)
+		int maximumTicksCount = CONFIGURATION_GAME_LOGIC_MAXIMUM_TICKS_PER_FRAME * (int) ceilf(_timeScale);
+		if (ticksCount > maximumTicksCount) ticksCount = maximumTicksCount;
+		
+		return ticksCount;
+	}
+
+	float getTicksInterpolationFactor()
+	{
+		return _ticksTimeAccumulator / CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS;
+	}
+
+	void setPaused(bool isPaused)
+	{
+		_isPaused = isPaused;
+		
+		// Forget about the time spent while paused
+		_previousRealTime = SDL_GetTicks();
+	}
+
+	bool isPaused()
+	{
+		return _isPaused;
+	}
+
+	void setTimeScale(float timeScale)
+	{
+		if (timeScale < CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE) timeScale = CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE;
+		else if (timeScale > CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE) timeScale = CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE;
+		
+		_timeScale = timeScale;
+		LOG_DEBUG("Game clock time scale set to %g.", _timeScale);
+	}
+
+	float getTimeScale()
+	{
+		return _timeScale;
+	}
+}
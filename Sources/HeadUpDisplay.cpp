@@ -47,6 +47,9 @@ namespace HeadUpDisplay
 	/** All compass arrows. */
 	static CompassArrow _compassArrows[COMPASS_ARROW_IDS_COUNT];
 
+	/** Set to true when the HUD is displayed, game logic updates are silently ignored otherwise (for instance in headless mode, where they could come from multiple simulation threads). */
+	static bool _isInitialized = false;
+
 	/** Display player life amount. */
 	static inline void _displayPlayerLifePointsAmount()
 	{
@@ -133,11 +136,14 @@ namespace HeadUpDisplay
 		_compassArrows[0].x = (Renderer::displayWidth - _compassArrows[0].pointerTurnedOffTexture->getWidth()) / 2;
 		_compassArrows[0].y = _compassArrows[2].y - _compassArrows[0].pointerTurnedOffTexture->getHeight() + 8;
 
+		_isInitialized = true;
 		return 0;
 	}
 
 	void setEnemiesAmount(int amount)
 	{
+		if (!_isInitialized) return;
+		
 		// Display enemies in green if they are all dead and all enemy spawners are destroyed
 		Renderer::TextColorId colorId;
 		if ((amount == 0) && (LevelManager::enemySpawnersList.empty())) colorId = Renderer::TEXT_COLOR_ID_GREEN;
@@ -158,6 +164,8 @@ namespace HeadUpDisplay
 	{
 		static MortarState previousMortarState = MORTAR_STATE_INVALID; // Initialize with an invalid value to make sure the first string is generated
 		
+		if (!_isInitialized) return;
+		
 		// Nothing to do if the string has been rendered yet
 		if (state == previousMortarState) return;
 		
@@ -198,6 +206,8 @@ namespace HeadUpDisplay
 
 	void setRemainingBonusTime(int timeSeconds)
 	{
+		if (!_isInitialized) return;
+		
 		if (timeSeconds == 0)
 		{
 			_isBonusRemainingSecondsStringDisplayed = false;
@@ -5,16 +5,21 @@
 #include <cassert>
 #include <cerrno>
 #include <Configuration.hpp>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <EnemyFightingEntity.hpp>
 #include <FileManager.hpp>
 #include <LevelManager.hpp>
 #include <list>
 #include <Log.hpp>
+#include <mutex>
 #include <PlayerFightingEntity.hpp>
+#include <RandomManager.hpp>
 #include <Renderer.hpp>
 #include <Texture.hpp>
 #include <TextureManager.hpp>
+#include <vector>
 
 namespace LevelManager
 {
@@ -45,17 +50,81 @@ namespace LevelManager
 	} ObjectId;
 
 	/** The level width in blocks. */
-	static int _levelWidthBlocks;
+	static thread_local int _levelWidthBlocks;
 	/** The level height in blocks. */
-	static int _levelHeightBlocks;
+	static thread_local int _levelHeightBlocks;
+
+	/** The level currently loaded by the calling thread, or -1 if no level is loaded. */
+	static thread_local int _loadedLevelNumber = -1;
 
 	/** The display width in blocks (rounded to the upper to make sure all the display is filled). */
 	static int _displayWidthBlocks;
 	/** The display height in blocks (rounded to the upper to make sure all the display is filled). */
 	static int _displayHeightBlocks;
 
-	/** Contain all level blocks. */
-	static Block _levelBlocks[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+	/** Contain all level blocks (each simulation thread has its own level). */
+	static thread_local Block _levelBlocks[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+
+	/** The blocks content bits stopping a line of sight. */
+	#define OBSTACLE_BLOCK_CONTENT (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)
+	/** How many blocks a bitmap word holds. */
+	#define BITMAP_WORD_BITS_COUNT 64
+	/** One bit per block telling whether the block is an obstacle, a level row after another. Testing a whole row range is a few words operations. */
+	static thread_local uint64_t _rowsObstaclesBitmap[CONFIGURATION_LEVEL_MAXIMUM_HEIGHT][CONFIGURATION_LEVEL_MAXIMUM_WIDTH / BITMAP_WORD_BITS_COUNT];
+	/** The same bits than _rowsObstaclesBitmap, but stored a level column after another, so a vertical range is contiguous too. */
+	static thread_local uint64_t _columnsObstaclesBitmap[CONFIGURATION_LEVEL_MAXIMUM_WIDTH][CONFIGURATION_LEVEL_MAXIMUM_HEIGHT / BITMAP_WORD_BITS_COUNT];
+	/** The blocks that became obstacles or stopped being obstacles since getObstaclesChanges() was last called. */
+	static thread_local std::vector<int> &_changedObstaclesBlocksIndexes = *new std::vector<int>();
+	/** Tell whether all obstacles were replaced since getObstaclesChanges() was last called. */
+	static thread_local bool _isWholeLevelObstaclesChanged = true;
+
+	/** The directions a distance field is computed for. */
+	typedef enum
+	{
+		DISTANCE_FIELD_DIRECTION_UP,
+		DISTANCE_FIELD_DIRECTION_DOWN,
+		DISTANCE_FIELD_DIRECTION_LEFT,
+		DISTANCE_FIELD_DIRECTION_RIGHT,
+		DISTANCE_FIELD_DIRECTIONS_COUNT
+	} DistanceFieldDirection;
+
+	/** The collision masks a distance field is computed for. Enemies move all the time, so they are not part of any field (see _getDistanceFromBlock()). */
+	static const int DISTANCE_FIELDS_BLOCK_CONTENTS[] =
+	{
+		BLOCK_CONTENT_WALL,
+		BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER
+	};
+	/** How many distance fields are computed. */
+	#define DISTANCE_FIELDS_COUNT ((int) (sizeof(DISTANCE_FIELDS_BLOCK_CONTENTS) / sizeof(DISTANCE_FIELDS_BLOCK_CONTENTS[0])))
+	/** For each collision mask and each direction, how many free blocks follow a block before an obstacle or the level border is reached. Values are stored at the same index than the block in _levelBlocks. */
+	static thread_local unsigned char _distanceFields[DISTANCE_FIELDS_COUNT][DISTANCE_FIELD_DIRECTIONS_COUNT][CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+
+	/** A level as it is right after its files were parsed. */
+	typedef struct
+	{
+		int widthBlocks; //!< The level width in blocks.
+		int heightBlocks; //!< The level height in blocks.
+		std::vector<Block> blocks; //!< The level blocks, stored a row after another.
+		int playerX; //!< The player spawning X coordinate (in pixels).
+		int playerY; //!< The player spawning Y coordinate (in pixels).
+		std::vector<int> enemySpawnersCoordinates; //!< The enemy spawners coordinates (in pixels), stored as (x, y) pairs in the order they were parsed.
+	} LevelTemplate;
+
+	/** The parsed levels, shared by all threads. A level is parsed once by the first thread loading it, then it is only read, so loading it again (when the level is restarted or by another simulation session) does not access the level files. */
+	static LevelTemplate _levelsTemplates[CONFIGURATION_LEVELS_COUNT];
+	/** Tell whether each level template was successfully parsed. */
+	static bool _isLevelTemplateParsed[CONFIGURATION_LEVELS_COUNT];
+	/** Make sure each level is parsed by a single thread. */
+	static std::once_flag _levelsTemplatesOnceFlags[CONFIGURATION_LEVELS_COUNT];
+
+	/** The enemies overlapping each block, stored at the same index than the block in _levelBlocks. Buckets keep their memory from one level to another, so enemies moves do not allocate memory once the buckets have grown. */
+	static thread_local std::vector<std::vector<EnemyFightingEntity *> > &_enemiesBlocksIndex = *new std::vector<std::vector<EnemyFightingEntity *> >();
+
+	/** How many enemies stand on each block, stored at the same index than the block in _levelBlocks. Several enemies can share a block, so one of them leaving the block must not clear the other ones presence. */
+	static thread_local std::vector<unsigned short> &_blocksEnemiesCounts = *new std::vector<unsigned short>();
+
+	/** The enemy spawner standing on each block (or NULL), stored at the same index than the block in _levelBlocks. Spawners never move, so a bullet finds the spawner it hits with a direct lookup. */
+	static thread_local std::vector<EnemySpawnerStaticEntity *> &_enemySpawnersBlocksIndex = *new std::vector<EnemySpawnerStaticEntity *>();
 
 	/** Cache medipack texture. */
 	static Texture *_pointerMedipackTexture;
@@ -67,9 +136,11 @@ namespace LevelManager
 	static Texture *_pointerMachineGunBonusTexture;
 	/** Cache bulletproof vest bonus texture. */
 	static Texture *_pointerBulletproofVestBonusTexture;
+	/** Cache homing rockets texture. */
+	static Texture *_pointerHomingRocketsTexture;
 
 	// Public variable, documentation is in the header file
-	std::list<EnemySpawnerStaticEntity *> enemySpawnersList;
+	thread_local std::list<EnemySpawnerStaticEntity *> &enemySpawnersList = *new std::list<EnemySpawnerStaticEntity *>(); // Never destroyed, so it is still available to the exit handlers
 
 	int initialize()
 	{
@@ -86,7 +157,8 @@ namespace LevelManager
 		_pointerAmmunitionTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_AMMUNITION);
 		_pointerMachineGunBonusTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_MACHINE_GUN);
 		_pointerBulletproofVestBonusTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_BULLETPROOF_VEST);
-
+		_pointerHomingRocketsTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_BULLET_MORTAR_SHELL_FACING_UP); // There is no dedicated texture, show a mortar shell standing in the block middle
+		
 		return 0;
 	}
 
@@ -95,14 +167,270 @@ namespace LevelManager
 		// TODO if needed
 	}
 
-	int loadLevel(int levelNumber)
+	/** Empty all blocks enemies buckets and enemy spawners entries, and make sure there is an entry for each block of the level being loaded. */
+	static void _clearBlocksIndexes()
+	{
+		unsigned int i, blocksCount = _levelWidthBlocks * _levelHeightBlocks;
+		
+		if (_enemiesBlocksIndex.size() < blocksCount) _enemiesBlocksIndex.resize(blocksCount);
+		for (i = 0; i < _enemiesBlocksIndex.size(); i++) _enemiesBlocksIndex[i].clear();
+		
+		_enemySpawnersBlocksIndex.assign(blocksCount, NULL);
+		_blocksEnemiesCounts.assign(blocksCount, 0);
+	}
+
+	/** Register an enemy spawner on the block it stands on.
+	 * @param pointerEnemySpawner The enemy spawner, its coordinates must be the ones of a level block.
+	 */
+	static void _addEnemySpawnerToBlock(EnemySpawnerStaticEntity *pointerEnemySpawner)
+	{
+		SDL_Rect *pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
+		int xBlock = pointerPositionRectangle->x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = pointerPositionRectangle->y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// A corrupted snapshot could put a spawner anywhere
+		if ((xBlock < 0) || (xBlock >= _levelWidthBlocks) || (yBlock < 0) || (yBlock >= _levelHeightBlocks)) return;
+		_enemySpawnersBlocksIndex[COMPUTE_BLOCK_INDEX(xBlock, yBlock)] = pointerEnemySpawner;
+	}
+
+	/** Convert a rectangle to the range of level blocks it overlaps, clipped to the level bounds.
+	 * @param pointerRectangle The rectangle in pixels.
+	 * @param pointerLeftBlockX On output, contain the leftmost block X coordinate.
+	 * @param pointerTopBlockY On output, contain the topmost block Y coordinate.
+	 * @param pointerRightBlockX On output, contain the rightmost block X coordinate.
+	 * @param pointerBottomBlockY On output, contain the downer block Y coordinate.
+	 * @return true if the rectangle overlaps at least one level block,
+	 * @return false if the rectangle is outside of the level.
+	 */
+	static bool _getRectangleBlocks(SDL_Rect *pointerRectangle, int *pointerLeftBlockX, int *pointerTopBlockY, int *pointerRightBlockX, int *pointerBottomBlockY)
+	{
+		if ((pointerRectangle->x < 0) || (pointerRectangle->y < 0) || (pointerRectangle->w <= 0) || (pointerRectangle->h <= 0)) return false;
+		
+		*pointerLeftBlockX = pointerRectangle->x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		*pointerTopBlockY = pointerRectangle->y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		*pointerRightBlockX = (pointerRectangle->x + pointerRectangle->w - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		*pointerBottomBlockY = (pointerRectangle->y + pointerRectangle->h - 1) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		if ((*pointerLeftBlockX >= _levelWidthBlocks) || (*pointerTopBlockY >= _levelHeightBlocks)) return false;
+		
+		if (*pointerRightBlockX >= _levelWidthBlocks) *pointerRightBlockX = _levelWidthBlocks - 1;
+		if (*pointerBottomBlockY >= _levelHeightBlocks) *pointerBottomBlockY = _levelHeightBlocks - 1;
+		return true;
+	}
+
+	/** Update the obstacles bitmaps after a block content changed.
+	 * @param xBlock The block X coordinate (in blocks).
+	 * @param yBlock The block Y coordinate (in blocks).
+	 */
+	static inline void _updateObstaclesBitmaps(int xBlock, int yBlock)
+	{
+		uint64_t rowBit = (uint64_t) 1 << (xBlock % BITMAP_WORD_BITS_COUNT), columnBit = (uint64_t) 1 << (yBlock % BITMAP_WORD_BITS_COUNT);
+		
+		if (_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content & OBSTACLE_BLOCK_CONTENT)
+		{
+			_rowsObstaclesBitmap[yBlock][xBlock / BITMAP_WORD_BITS_COUNT] |= rowBit;
+			_columnsObstaclesBitmap[xBlock][yBlock / BITMAP_WORD_BITS_COUNT] |= columnBit;
+		}
+		else
+		{
+			_rowsObstaclesBitmap[yBlock][xBlock / BITMAP_WORD_BITS_COUNT] &= ~rowBit;
+			_columnsObstaclesBitmap[xBlock][yBlock / BITMAP_WORD_BITS_COUNT] &= ~columnBit;
+		}
+	}
+
+	/** Compute the obstacles bitmaps of the whole level, after all blocks content changed at once. */
+	static void _buildObstaclesBitmaps()
+	{
+		int x, y;
+		
+		_isWholeLevelObstaclesChanged = true;
+		_changedObstaclesBlocksIndexes.clear();
+		memset(_rowsObstaclesBitmap, 0, sizeof(_rowsObstaclesBitmap));
+		memset(_columnsObstaclesBitmap, 0, sizeof(_columnsObstaclesBitmap));
+		for (y = 0; y < _levelHeightBlocks; y++)
+		{
+			for (x = 0; x < _levelWidthBlocks; x++) _updateObstaclesBitmaps(x, y);
+		}
+	}
+
+	/** Tell if a bitmap line contains an obstacle in a range.
+	 * @param pointerWords The row or column bitmap.
+	 * @param firstBit The first bit of the range.
+	 * @param lastBit The bit following the last bit of the range (it is not tested).
+	 * @return true if at least one bit is set in the range,
+	 * @return false if all bits of the range are cleared.
+	 */
+	static inline bool _isBitmapRangeSet(uint64_t *pointerWords, int firstBit, int lastBit)
+	{
+		int wordIndex, lastWordIndex;
+		uint64_t mask;
+		
+		if (firstBit >= lastBit) return false;
+		
+		wordIndex = firstBit / BITMAP_WORD_BITS_COUNT;
+		lastWordIndex = (lastBit - 1) / BITMAP_WORD_BITS_COUNT;
+		mask = ~(uint64_t) 0 << (firstBit % BITMAP_WORD_BITS_COUNT); // Ignore the bits preceding the range in the first word
+		while (wordIndex < lastWordIndex)
+		{
+			if (pointerWords[wordIndex] & mask) return true;
+			mask = ~(uint64_t) 0;
+			wordIndex++;
+		}
+		
+		// Ignore the bits following the range in the last word
+		mask &= ~(uint64_t) 0 >> (BITMAP_WORD_BITS_COUNT - 1 - ((lastBit - 1) % BITMAP_WORD_BITS_COUNT));
+		return (pointerWords[wordIndex] & mask) != 0;
+	}
+
+	/** Compute the left and right distance fields of a level row.
+	 * @param yBlock The row Y coordinate (in blocks).
+	 */
+	static void _updateRowDistanceFields(int yBlock)
+	{
+		int fieldIndex, x, blockIndex, freeBlocksCount;
+		unsigned char *pointerField;
+		
+		for (fieldIndex = 0; fieldIndex < DISTANCE_FIELDS_COUNT; fieldIndex++)
+		{
+			// Count the free blocks from the left border
+			pointerField = _distanceFields[fieldIndex][DISTANCE_FIELD_DIRECTION_LEFT];
+			freeBlocksCount = 0;
+			for (x = 0; x < _levelWidthBlocks; x++)
+			{
+				blockIndex = COMPUTE_BLOCK_INDEX(x, yBlock);
+				pointerField[blockIndex] = (unsigned char) freeBlocksCount;
+				if (_levelBlocks[blockIndex].content & DISTANCE_FIELDS_BLOCK_CONTENTS[fieldIndex]) freeBlocksCount = 0;
+				else freeBlocksCount++;
+			}
+			
+			// Count the free blocks from the right border
+			pointerField = _distanceFields[fieldIndex][DISTANCE_FIELD_DIRECTION_RIGHT];
+			freeBlocksCount = 0;
+			for (x = _levelWidthBlocks - 1; x >= 0; x--)
+			{
+				blockIndex = COMPUTE_BLOCK_INDEX(x, yBlock);
+				pointerField[blockIndex] = (unsigned char) freeBlocksCount;
+				if (_levelBlocks[blockIndex].content & DISTANCE_FIELDS_BLOCK_CONTENTS[fieldIndex]) freeBlocksCount = 0;
+				else freeBlocksCount++;
+			}
+		}
+	}
+
+	/** Compute the up and down distance fields of a level column.
+	 * @param xBlock The column X coordinate (in blocks).
+	 */
+	static void _updateColumnDistanceFields(int xBlock)
+	{
+		int fieldIndex, y, blockIndex, freeBlocksCount;
+		unsigned char *pointerField;
+		
+		for (fieldIndex = 0; fieldIndex < DISTANCE_FIELDS_COUNT; fieldIndex++)
+		{
+			// Count the free blocks from the top border
+			pointerField = _distanceFields[fieldIndex][DISTANCE_FIELD_DIRECTION_UP];
+			freeBlocksCount = 0;
+			for (y = 0; y < _levelHeightBlocks; y++)
+			{
+				blockIndex = COMPUTE_BLOCK_INDEX(xBlock, y);
+				pointerField[blockIndex] = (unsigned char) freeBlocksCount;
+				if (_levelBlocks[blockIndex].content & DISTANCE_FIELDS_BLOCK_CONTENTS[fieldIndex]) freeBlocksCount = 0;
+				else freeBlocksCount++;
+			}
+			
+			// Count the free blocks from the bottom border
+			pointerField = _distanceFields[fieldIndex][DISTANCE_FIELD_DIRECTION_DOWN];
+			freeBlocksCount = 0;
+			for (y = _levelHeightBlocks - 1; y >= 0; y--)
+			{
+				blockIndex = COMPUTE_BLOCK_INDEX(xBlock, y);
+				pointerField[blockIndex] = (unsigned char) freeBlocksCount;
+				if (_levelBlocks[blockIndex].content & DISTANCE_FIELDS_BLOCK_CONTENTS[fieldIndex]) freeBlocksCount = 0;
+				else freeBlocksCount++;
+			}
+		}
+	}
+
+	/** Compute the distance fields of the whole level, after all blocks content changed at once. */
+	static void _buildDistanceFields()
+	{
+		int i;
+		
+		for (i = 0; i < _levelHeightBlocks; i++) _updateRowDistanceFields(i);
+		for (i = 0; i < _levelWidthBlocks; i++) _updateColumnDistanceFields(i);
+	}
+
+	/** Compute the distance in pixels separating a point from the first block containing some content in a direction.
+	 * @param xBlock The point X coordinate (in blocks).
+	 * @param yBlock The point Y coordinate (in blocks).
+	 * @param blockContent The type of block to check (wall, enemy spawner...). Block types can be ORed to check multiple blocks at a time.
+	 * @param direction Where to look for the block.
+	 * @param distanceToNextBlock How many pixels separate the point from the next block in the requested direction.
+	 * @return The distance in pixels.
+	 */
+	static int _getDistanceFromBlock(int xBlock, int yBlock, int blockContent, DistanceFieldDirection direction, int distanceToNextBlock)
+	{
+		int blockIndex, nextBlockIndex, fieldIndex, staticBlockContent, distance;
+		
+		// Tell that the walls are close if the requested coordinates are (out of) level bounds
+		if ((xBlock <= 0) || (xBlock >= _levelWidthBlocks - 1) || (yBlock <= 0) || (yBlock >= _levelHeightBlocks - 1)) return 0;
+		
+		// Is this block a wall ?
+		blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		if (_levelBlocks[blockIndex].content & blockContent) return 0;
+		
+		switch (direction)
+		{
+			case DISTANCE_FIELD_DIRECTION_UP:
+				nextBlockIndex = blockIndex - _levelWidthBlocks;
+				break;
+			case DISTANCE_FIELD_DIRECTION_DOWN:
+				nextBlockIndex = blockIndex + _levelWidthBlocks;
+				break;
+			case DISTANCE_FIELD_DIRECTION_LEFT:
+				nextBlockIndex = blockIndex - 1;
+				break;
+			default:
+				nextBlockIndex = blockIndex + 1;
+				break;
+		}
+		
+		// Find the distance field matching the blocks that do not move
+		staticBlockContent = blockContent & ~BLOCK_CONTENT_ENEMY;
+		for (fieldIndex = 0; fieldIndex < DISTANCE_FIELDS_COUNT; fieldIndex++)
+		{
+			if (DISTANCE_FIELDS_BLOCK_CONTENTS[fieldIndex] == staticBlockContent) break;
+		}
+		
+		// There is no field for this mask, look at the next block only
+		if (fieldIndex == DISTANCE_FIELDS_COUNT)
+		{
+			if (!(_levelBlocks[nextBlockIndex].content & blockContent)) return CONFIGURATION_LEVEL_BLOCK_SIZE; // Do not check further to optimize function speed
+			return distanceToNextBlock;
+		}
+		
+		// Walls and enemy spawners can be far away
+		distance = distanceToNextBlock + _distanceFields[fieldIndex][direction][blockIndex] * CONFIGURATION_LEVEL_BLOCK_SIZE;
+		if (!(blockContent & BLOCK_CONTENT_ENEMY)) return distance;
+		
+		// Enemies are looked for on the next block only, so the distance can't go beyond this block
+		if (distance <= distanceToNextBlock) return distance;
+		if (_levelBlocks[nextBlockIndex].content & BLOCK_CONTENT_ENEMY) return distanceToNextBlock;
+		if (distance > distanceToNextBlock + CONFIGURATION_LEVEL_BLOCK_SIZE) return distanceToNextBlock + CONFIGURATION_LEVEL_BLOCK_SIZE;
+		return distance;
+	}
+
+	/** Parse a level files into a level template.
+	 * @param levelNumber The level number.
+	 * @param pointerLevelTemplate On output, contain the parsed level.
+	 * @return -1 if an error occurred,
+	 * @return 0 if the level was successfully parsed.
+	 */
+	static int _parseLevel(int levelNumber, LevelTemplate *pointerLevelTemplate)
 	{
 		FILE *pointerFile;
-		int x, y, character, i, objectId, isPlayerSpawned = 0;
+		int x, y, character, i, objectId, isPlayerSpawned = 0, blockIndex;
 		TextureManager::TextureId textureId;
 		char stringFileName[256];
-		
-		LOG_DEBUG("Loading level %d...", levelNumber);
+		Block *pointerBlock;
 		
 		// Try to open the scene file
 		snprintf(stringFileName, sizeof(stringFileName), FileManager::getFilePath("Levels/%d_Scene.csv"), levelNumber);
@@ -113,8 +441,9 @@ namespace LevelManager
 			return -1;
 		}
 		
-		_levelWidthBlocks = 0;
-		_levelHeightBlocks = 0;
+		pointerLevelTemplate->widthBlocks = 0;
+		pointerLevelTemplate->heightBlocks = 0;
+		pointerLevelTemplate->blocks.resize(CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT);
 		
 		// Parse the whole file considering it does not contain errors
 		i = 0;
@@ -126,11 +455,12 @@ namespace LevelManager
 				if (fscanf(pointerFile, "%d", (int *) &textureId) != 1) goto Scene_Loading_End;
 				
 				// Set block texture
-				_levelBlocks[i].pointerTexture = TextureManager::getTextureFromId(textureId);
+				pointerBlock = &pointerLevelTemplate->blocks[i];
+				pointerBlock->pointerTexture = TextureManager::getTextureFromId(textureId);
 				
 				// Set block collision
-				if (textureId < TextureManager::TEXTURE_ID_SCENE_WALL_0) _levelBlocks[i].content = 0; // This is a floor block, it does not collide with nothing
-				else if (textureId < TextureManager::TEXTURE_ID_MEDIPACK) _levelBlocks[i].content = BLOCK_CONTENT_WALL; // This is a wall block
+				if (textureId < TextureManager::TEXTURE_ID_SCENE_WALL_0) pointerBlock->content = 0; // This is a floor block, it does not collide with nothing
+				else if (textureId < TextureManager::TEXTURE_ID_MEDIPACK) pointerBlock->content = BLOCK_CONTENT_WALL; // This is a wall block
 				else
 				{
 					LOG_ERROR("Block (%d, %d) ID is bad : %d.", x, y, (int) textureId);
@@ -144,15 +474,16 @@ namespace LevelManager
 				// Load next row if a newline character is found
 				if (character == '\n' || character == '\r')
 				{
-					_levelWidthBlocks = x + 1; // Set level width in the same time
+					pointerLevelTemplate->widthBlocks = x + 1; // Set level width in the same time
 					break;
 				}
 			}
 		}
 		
 	Scene_Loading_End:
-		_levelHeightBlocks = y;
-		LOG_DEBUG("Level size : %dx%d blocks.", _levelWidthBlocks, _levelHeightBlocks);
+		pointerLevelTemplate->heightBlocks = y;
+		pointerLevelTemplate->blocks.resize(pointerLevelTemplate->widthBlocks * pointerLevelTemplate->heightBlocks);
+		LOG_DEBUG("Level size : %dx%d blocks.", pointerLevelTemplate->widthBlocks, pointerLevelTemplate->heightBlocks);
 		fclose(pointerFile);
 		
 		// Try to open the objects file
@@ -165,9 +496,9 @@ namespace LevelManager
 		}
 		
 		// Spawn objects
-		for (y = 0; y < _levelHeightBlocks; y++)
+		for (y = 0; y < pointerLevelTemplate->heightBlocks; y++)
 		{
-			for (x = 0; x < _levelWidthBlocks; x++)
+			for (x = 0; x < pointerLevelTemplate->widthBlocks; x++)
 			{
 				// Read an object index
 				if (fscanf(pointerFile, "%d", &objectId) != 1)
@@ -175,6 +506,7 @@ namespace LevelManager
 					LOG_ERROR("Failed to read the object (%d, %d) value. Make sure the objects file has the same dimensions than the scene file.", x, y);
 					goto Objects_Loading_Error;
 				}
+				blockIndex = (y * pointerLevelTemplate->widthBlocks) + x;
 				
 				// Spawn the requested object
 				switch (objectId)
@@ -198,36 +530,37 @@ namespace LevelManager
 							int playerHeight = pointerTexture->getHeight();
 							
 							// Put the player at the block center
-							pointerPlayer->setX((x * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - playerWidth) / 2));
-							pointerPlayer->setY((y * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - playerHeight) / 2));
+							pointerLevelTemplate->playerX = (x * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - playerWidth) / 2);
+							pointerLevelTemplate->playerY = (y * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - playerHeight) / 2);
 							isPlayerSpawned = 1;
 							LOG_DEBUG("Spawned player on block (%d, %d).", x, y);
 						}
 						break;
 						
 					case OBJECT_ID_MEDIPACK:
-						_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_MEDIPACK;
+						pointerLevelTemplate->blocks[blockIndex].content |= BLOCK_CONTENT_MEDIPACK;
 						LOG_DEBUG("Spawned medipack on block (%d, %d).", x, y);
 						break;
 						
 					case OBJECT_ID_GOLDEN_MEDIPACK:
-						_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_GOLDEN_MEDIPACK;
+						pointerLevelTemplate->blocks[blockIndex].content |= BLOCK_CONTENT_GOLDEN_MEDIPACK;
 						LOG_DEBUG("Spawned golden medipack on block (%d, %d).", x, y);
 						break;
 						
 					case OBJECT_ID_AMMUNITION:
-						_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_AMMUNITION;
+						pointerLevelTemplate->blocks[blockIndex].content |= BLOCK_CONTENT_AMMUNITION;
 						LOG_DEBUG("Spawned ammunition on block (%d, %d).", x, y);
 						break;
 						
 					case OBJECT_ID_ENEMY_SPAWNER:
-						enemySpawnersList.push_front(new EnemySpawnerStaticEntity(x * CONFIGURATION_LEVEL_BLOCK_SIZE, y * CONFIGURATION_LEVEL_BLOCK_SIZE));
-						_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_ENEMY_SPAWNER;
+						pointerLevelTemplate->enemySpawnersCoordinates.push_back(x * CONFIGURATION_LEVEL_BLOCK_SIZE);
+						pointerLevelTemplate->enemySpawnersCoordinates.push_back(y * CONFIGURATION_LEVEL_BLOCK_SIZE);
+						pointerLevelTemplate->blocks[blockIndex].content |= BLOCK_CONTENT_ENEMY_SPAWNER;
 						LOG_DEBUG("Spawned enemy spawner on block (%d, %d).", x, y);
 						break;
 						
 					case OBJECT_ID_LEVEL_EXIT:
-						_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_LEVEL_EXIT;
+						pointerLevelTemplate->blocks[blockIndex].content |= BLOCK_CONTENT_LEVEL_EXIT;
 						LOG_DEBUG("Spawned level exit on block (%d, %d).", x, y);
 						break;
 						
@@ -249,15 +582,161 @@ namespace LevelManager
 		}
 		
 		fclose(pointerFile);
-		
-		LOG_INFORMATION("Level %d successfully loaded.", levelNumber);
 		return 0;
-		
+	
 	Objects_Loading_Error:
 		fclose(pointerFile);
 		return -1;
 	}
 
+	/** Parse a level template if it was not parsed yet. This function is called once per level by std::call_once().
+	 * @param levelNumber The level number.
+	 */
+	static void _parseLevelTemplate(int levelNumber)
+	{
+		_isLevelTemplateParsed[levelNumber] = (_parseLevel(levelNumber, &_levelsTemplates[levelNumber]) == 0);
+	}
+
+	int loadLevel(int levelNumber)
+	{
+		int i, x, y, enemySpawnersCoordinatesCount;
+		EnemySpawnerStaticEntity *pointerEnemySpawner;
+		LevelTemplate *pointerLevelTemplate;
+		
+		LOG_DEBUG("Loading level %d...", levelNumber);
+		_loadedLevelNumber = -1; // The level is partially loaded until the end of this function
+		
+		// Only the first thread loading the level parses its files, the other ones wait for the parsing to end
+		if ((levelNumber < 0) || (levelNumber >= CONFIGURATION_LEVELS_COUNT))
+		{
+			LOG_ERROR("Level %d does not exist.", levelNumber);
+			return -1;
+		}
+		std::call_once(_levelsTemplatesOnceFlags[levelNumber], _parseLevelTemplate, levelNumber);
+		if (!_isLevelTemplateParsed[levelNumber]) return -1;
+		pointerLevelTemplate = &_levelsTemplates[levelNumber];
+		
+		// Copy the level template to this thread world
+		_levelWidthBlocks = pointerLevelTemplate->widthBlocks;
+		_levelHeightBlocks = pointerLevelTemplate->heightBlocks;
+		memcpy(_levelBlocks, &pointerLevelTemplate->blocks[0], sizeof(Block) * _levelWidthBlocks * _levelHeightBlocks);
+		_clearBlocksIndexes();
+		
+		pointerPlayer->setX(pointerLevelTemplate->playerX);
+		pointerPlayer->setY(pointerLevelTemplate->playerY);
+		
+		// Spawn enemy spawners in the level parsing order, so the game is the same whichever thread parsed the level
+		enemySpawnersCoordinatesCount = (int) pointerLevelTemplate->enemySpawnersCoordinates.size();
+		for (i = 0; i < enemySpawnersCoordinatesCount; i += 2)
+		{
+			x = pointerLevelTemplate->enemySpawnersCoordinates[i];
+			y = pointerLevelTemplate->enemySpawnersCoordinates[i + 1];
+			pointerEnemySpawner = new EnemySpawnerStaticEntity(x, y);
+			enemySpawnersList.push_front(pointerEnemySpawner);
+			_addEnemySpawnerToBlock(pointerEnemySpawner);
+		}
+		
+		_buildObstaclesBitmaps();
+		_buildDistanceFields();
+		
+		_loadedLevelNumber = levelNumber;
+		LOG_INFORMATION("Level %d successfully loaded.", levelNumber);
+		return 0;
+	}
+
+	int getLoadedLevelNumber()
+	{
+		return _loadedLevelNumber;
+	}
+
+	int getLevelWidthBlocks()
+	{
+		return _levelWidthBlocks;
+	}
+
+	int getLevelHeightBlocks()
+	{
+		return _levelHeightBlocks;
+	}
+
+	void saveState(Snapshot *pointerSnapshot)
+	{
+		int i, blocksCount, runStartingIndex;
+		
+		// Blocks textures never change, only store their content (it contains long runs of the same value, like wall or floor areas, so compress it with run-length encoding)
+		pointerSnapshot->writeInteger(_levelWidthBlocks);
+		pointerSnapshot->writeInteger(_levelHeightBlocks);
+		blocksCount = _levelWidthBlocks * _levelHeightBlocks;
+		runStartingIndex = 0;
+		for (i = 1; i <= blocksCount; i++)
+		{
+			if ((i == blocksCount) || (_levelBlocks[i].content != _levelBlocks[runStartingIndex].content))
+			{
+				pointerSnapshot->writeInteger(i - runStartingIndex);
+				pointerSnapshot->writeInteger(_levelBlocks[runStartingIndex].content);
+				runStartingIndex = i;
+			}
+		}
+		
+		// Enemy spawners
+		std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+		pointerSnapshot->writeInteger(enemySpawnersList.size());
+		for (enemySpawnersListIterator = enemySpawnersList.begin(); enemySpawnersListIterator != enemySpawnersList.end(); ++enemySpawnersListIterator) (*enemySpawnersListIterator)->saveState(pointerSnapshot);
+	}
+
+	int restoreState(Snapshot *pointerSnapshot)
+	{
+		int i, j, blocksCount, runLength, content, enemySpawnersCount;
+		EnemySpawnerStaticEntity *pointerEnemySpawner;
+		
+		// Make sure the snapshot was taken from the loaded level
+		if ((pointerSnapshot->readInteger() != _levelWidthBlocks) || (pointerSnapshot->readInteger() != _levelHeightBlocks))
+		{
+			LOG_ERROR("Snapshot level dimensions do not match level %d ones.", _loadedLevelNumber);
+			return -1;
+		}
+		
+		// Decode blocks content
+		blocksCount = _levelWidthBlocks * _levelHeightBlocks;
+		i = 0;
+		while (i < blocksCount)
+		{
+			runLength = pointerSnapshot->readInteger();
+			content = pointerSnapshot->readInteger();
+			if ((runLength <= 0) || (runLength > blocksCount - i))
+			{
+				LOG_ERROR("Snapshot blocks content is corrupted.");
+				return -1;
+			}
+			
+			for (j = 0; j < runLength; j++)
+			{
+				// The enemies presence comes from the enemies that are already restored
+				_levelBlocks[i + j].content = content & ~BLOCK_CONTENT_ENEMY;
+				if (_blocksEnemiesCounts[i + j] > 0) _levelBlocks[i + j].content |= BLOCK_CONTENT_ENEMY;
+			}
+			i += runLength;
+		}
+		_buildObstaclesBitmaps();
+		_buildDistanceFields();
+		
+		// Replace enemy spawners
+		std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+		for (enemySpawnersListIterator = enemySpawnersList.begin(); enemySpawnersListIterator != enemySpawnersList.end(); ++enemySpawnersListIterator) delete *enemySpawnersListIterator;
+		enemySpawnersList.clear();
+		_enemySpawnersBlocksIndex.assign(blocksCount, NULL);
+		enemySpawnersCount = pointerSnapshot->readInteger();
+		for (i = 0; (i < enemySpawnersCount) && !pointerSnapshot->isReadingFailed(); i++)
+		{
+			pointerEnemySpawner = new EnemySpawnerStaticEntity(0, 0);
+			pointerEnemySpawner->restoreState(pointerSnapshot);
+			enemySpawnersList.push_back(pointerEnemySpawner);
+			_addEnemySpawnerToBlock(pointerEnemySpawner);
+		}
+		
+		return 0;
+	}
+
 	void renderScene(int topLeftX, int topLeftY)
 	{
 		// Get the amount of pixels the rendering must be shifted about in the beginning blocks
@@ -299,6 +778,7 @@ namespace LevelManager
 					else if (pointerBlock->content & BLOCK_CONTENT_AMMUNITION) _pointerAmmunitionTexture->render(xPixel, yPixel);
 					else if (pointerBlock->content & BLOCK_CONTENT_MACHINE_GUN_BONUS) _pointerMachineGunBonusTexture->render(xPixel, yPixel);
 					else if (pointerBlock->content & BLOCK_CONTENT_BULLETPROOF_VEST_BONUS) _pointerBulletproofVestBonusTexture->render(xPixel, yPixel);
+					else if (pointerBlock->content & BLOCK_CONTENT_HOMING_ROCKETS) _pointerHomingRocketsTexture->render(xPixel + ((CONFIGURATION_LEVEL_BLOCK_SIZE - _pointerHomingRocketsTexture->getWidth()) / 2), yPixel + ((CONFIGURATION_LEVEL_BLOCK_SIZE - _pointerHomingRocketsTexture->getHeight()) / 2));
 				}
 				
 				xPixel += CONFIGURATION_LEVEL_BLOCK_SIZE;
@@ -309,78 +789,22 @@ namespace LevelManager
 
 	int getDistanceFromUpperBlock(int x, int y, int blockContent)
 	{
-		// Convert to block coordinates
-		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Tell that the walls are close if the requested coordinates are (out of) level bounds
-		if ((xBlock <= 0) || (xBlock >= _levelWidthBlocks - 1) || (yBlock <= 0) || (yBlock >= _levelWidthBlocks - 1)) return 0;
-		
-		// Is this block a wall ?
-		if (_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content & blockContent) return 0;
-		
-		// Is upper block part of the floor ?
-		if (!(_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock - 1)].content & blockContent)) return CONFIGURATION_LEVEL_BLOCK_SIZE; // Do not check further to optimize function speed
-		
-		// The upper block is a wall, compute the amount of pixels separating the provided coordinates from the wall
-		return y % CONFIGURATION_LEVEL_BLOCK_SIZE;
+		return _getDistanceFromBlock(x / CONFIGURATION_LEVEL_BLOCK_SIZE, y / CONFIGURATION_LEVEL_BLOCK_SIZE, blockContent, DISTANCE_FIELD_DIRECTION_UP, y % CONFIGURATION_LEVEL_BLOCK_SIZE);
 	}
 
 	int getDistanceFromDownerBlock(int x, int y, int blockContent)
 	{
-		// Convert to block coordinates
-		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Tell that the walls are close if the requested coordinates are (out of) level bounds
-		if ((xBlock <= 0) || (xBlock >= _levelWidthBlocks - 1) || (yBlock <= 0) || (yBlock >= _levelWidthBlocks - 1)) return 0;
-		
-		// Is this block a wall ?
-		if (_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content & blockContent) return 0;
-		
-		// Is upper block part of the floor ?
-		if (!(_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock + 1)].content & blockContent)) return CONFIGURATION_LEVEL_BLOCK_SIZE; // Do not check further to optimize function speed
-		
-		// The upper block is a wall, compute the amount of pixels separating the provided coordinates from the wall
-		return CONFIGURATION_LEVEL_BLOCK_SIZE - (y % CONFIGURATION_LEVEL_BLOCK_SIZE);
+		return _getDistanceFromBlock(x / CONFIGURATION_LEVEL_BLOCK_SIZE, y / CONFIGURATION_LEVEL_BLOCK_SIZE, blockContent, DISTANCE_FIELD_DIRECTION_DOWN, CONFIGURATION_LEVEL_BLOCK_SIZE - (y % CONFIGURATION_LEVEL_BLOCK_SIZE));
 	}
 
 	int getDistanceFromLeftmostBlock(int x, int y, int blockContent)
 	{
-		// Convert to block coordinates
-		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Tell that the walls are close if the requested coordinates are (out of) level bounds
-		if ((xBlock <= 0) || (xBlock >= _levelWidthBlocks - 1) || (yBlock <= 0) || (yBlock >= _levelWidthBlocks - 1)) return 0;
-		
-		// Is this block a wall ?
-		if (_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content & blockContent) return 0;
-		
-		// Is upper block part of the floor ?
-		if (!(_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock - 1, yBlock)].content & blockContent)) return CONFIGURATION_LEVEL_BLOCK_SIZE; // Do not check further to optimize function speed
-		
-		// The upper block is a wall, compute the amount of pixels separating the provided coordinates from the wall
-		return x % CONFIGURATION_LEVEL_BLOCK_SIZE;
+		return _getDistanceFromBlock(x / CONFIGURATION_LEVEL_BLOCK_SIZE, y / CONFIGURATION_LEVEL_BLOCK_SIZE, blockContent, DISTANCE_FIELD_DIRECTION_LEFT, x % CONFIGURATION_LEVEL_BLOCK_SIZE);
 	}
 
 	int getDistanceFromRightmostBlock(int x, int y, int blockContent)
 	{
-		// Convert to block coordinates
-		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Tell that the walls are close if the requested coordinates are (out of) level bounds
-		if ((xBlock <= 0) || (xBlock >= _levelWidthBlocks - 1) || (yBlock <= 0) || (yBlock >= _levelWidthBlocks - 1)) return 0;
-		
-		// Is this block a wall ?
-		if (_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content & blockContent) return 0;
-		
-		// Is upper block part of the floor ?
-		if (!(_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock + 1, yBlock)].content & blockContent)) return CONFIGURATION_LEVEL_BLOCK_SIZE; // Do not check further to optimize function speed
-		
-		// The upper block is a wall, compute the amount of pixels separating the provided coordinates from the wall
-		return CONFIGURATION_LEVEL_BLOCK_SIZE - (x % CONFIGURATION_LEVEL_BLOCK_SIZE);
+		return _getDistanceFromBlock(x / CONFIGURATION_LEVEL_BLOCK_SIZE, y / CONFIGURATION_LEVEL_BLOCK_SIZE, blockContent, DISTANCE_FIELD_DIRECTION_RIGHT, CONFIGURATION_LEVEL_BLOCK_SIZE - (x % CONFIGURATION_LEVEL_BLOCK_SIZE));
 	}
 
 	bool isObstaclePresentOnVerticalAxis(int topmostY, int downerY, int x)
@@ -399,13 +823,7 @@ namespace LevelManager
 		assert(x < _levelWidthBlocks);
 		
 		// Check all blocks along between the specified coordinates
-		while (topmostY < downerY)
-		{
-			if (_levelBlocks[COMPUTE_BLOCK_INDEX(x, topmostY)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) return true;
-			topmostY++;
-		}
-		
-		return false;
+		return _isBitmapRangeSet(_columnsObstaclesBitmap[x], topmostY, downerY);
 	}
 
 	bool isObstaclePresentOnHorizontalAxis(int leftmostX, int rightmostX, int y)
@@ -424,13 +842,24 @@ namespace LevelManager
 		assert(y < _levelHeightBlocks);
 		
 		// Check all blocks along between the specified coordinates
-		while (leftmostX < rightmostX)
-		{
-			if (_levelBlocks[COMPUTE_BLOCK_INDEX(leftmostX, y)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) return true;
-			leftmostX++;
-		}
+		return _isBitmapRangeSet(_rowsObstaclesBitmap[y], leftmostX, rightmostX);
+	}
+
+	bool isObstacleBlock(int xBlock, int yBlock)
+	{
+		if ((xBlock < 0) || (xBlock >= _levelWidthBlocks) || (yBlock < 0) || (yBlock >= _levelHeightBlocks)) return true;
+		return (_rowsObstaclesBitmap[yBlock][xBlock / BITMAP_WORD_BITS_COUNT] >> (xBlock % BITMAP_WORD_BITS_COUNT)) & 1;
+	}
+
+	int getObstaclesChanges(std::vector<int> *pointerChangedBlocksIndexes)
+	{
+		int result = _isWholeLevelObstaclesChanged;
 		
-		return false;
+		// Exchange the vectors to keep both memory allocations
+		pointerChangedBlocksIndexes->clear();
+		pointerChangedBlocksIndexes->swap(_changedObstaclesBlocksIndexes);
+		_isWholeLevelObstaclesChanged = false;
+		return result;
 	}
 
 	int getBlockContent(int x, int y)
@@ -460,7 +889,19 @@ namespace LevelManager
 		assert(yBlock >= 0);
 		assert(yBlock < _levelHeightBlocks);
 		
-		_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content = content;
+		Block *pointerBlock = &_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)];
+		int changedBlockContent = pointerBlock->content ^ content;
+		
+		pointerBlock->content = content;
+		_updateObstaclesBitmaps(xBlock, yBlock);
+		
+		// Only walls and enemy spawners are part of the distance fields
+		if (changedBlockContent & OBSTACLE_BLOCK_CONTENT)
+		{
+			_changedObstaclesBlocksIndexes.push_back(COMPUTE_BLOCK_INDEX(xBlock, yBlock));
+			_updateRowDistanceFields(yBlock);
+			_updateColumnDistanceFields(xBlock);
+		}
 	}
 
 	void spawnItem(int x, int y)
@@ -469,16 +910,16 @@ namespace LevelManager
 		
 		// Spawn nothing if the block contains an item yet
 		blockContent = getBlockContent(x, y);
-		int itemsBitMask = BLOCK_CONTENT_MEDIPACK | BLOCK_CONTENT_GOLDEN_MEDIPACK | BLOCK_CONTENT_AMMUNITION | BLOCK_CONTENT_MACHINE_GUN_BONUS | BLOCK_CONTENT_BULLETPROOF_VEST_BONUS;
+		int itemsBitMask = BLOCK_CONTENT_MEDIPACK | BLOCK_CONTENT_GOLDEN_MEDIPACK | BLOCK_CONTENT_AMMUNITION | BLOCK_CONTENT_MACHINE_GUN_BONUS | BLOCK_CONTENT_BULLETPROOF_VEST_BONUS | BLOCK_CONTENT_HOMING_ROCKETS;
 		if (blockContent & itemsBitMask) return;
 		
 		// Make pickable items (like ammunition or medipacks) spawn more frequently
-		if (rand() % 100 < 75)
+		if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < 75)
 		{
 			// Spawn a medipack
-			if (rand() % 2 == 0)
+			if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 2) == 0)
 			{
-				if (rand() % 100 < CONFIGURATION_GAMEPLAY_MEDIPACK_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
+				if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < CONFIGURATION_GAMEPLAY_MEDIPACK_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
 				{
 					// Spawn the item
 					blockContent |= BLOCK_CONTENT_MEDIPACK;
@@ -490,7 +931,7 @@ namespace LevelManager
 			// Spawn ammunition
 			else
 			{
-				if (rand() % 100 < CONFIGURATION_GAMEPLAY_AMMUNITION_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
+				if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < CONFIGURATION_GAMEPLAY_AMMUNITION_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
 				{
 					// Spawn the item
 					blockContent |= BLOCK_CONTENT_AMMUNITION;
@@ -504,9 +945,9 @@ namespace LevelManager
 		else
 		{
 			// Spawn machine gun bonus
-			if (rand() % 2 == 0)
+			if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 2) == 0)
 			{
-				if (rand() % 100 < CONFIGURATION_GAMEPLAY_MACHINE_GUN_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
+				if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < CONFIGURATION_GAMEPLAY_MACHINE_GUN_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
 				{
 					// Spawn the item
 					blockContent |= BLOCK_CONTENT_MACHINE_GUN_BONUS;
@@ -518,7 +959,7 @@ namespace LevelManager
 			// Spawn bulletproof vest bonus
 			else
 			{
-				if (rand() % 100 < CONFIGURATION_GAMEPLAY_BULLETPROOF_VEST_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
+				if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < CONFIGURATION_GAMEPLAY_BULLETPROOF_VEST_BONUS_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
 				{
 					// Spawn the item
 					blockContent |= BLOCK_CONTENT_BULLETPROOF_VEST_BONUS;
@@ -527,6 +968,217 @@ namespace LevelManager
 					LOG_DEBUG("Enemy dropped bulletproof vest bonus.");
 				}
 			}
+			
+			// Spawn homing rockets with a separate roll when no other bonus was dropped, so the other bonuses keep their drop rates
+			if (!(blockContent & (BLOCK_CONTENT_MACHINE_GUN_BONUS | BLOCK_CONTENT_BULLETPROOF_VEST_BONUS)))
+			{
+				if (RandomManager::generateNumber(RandomManager::STREAM_ID_ITEM_LOOT, 100) < CONFIGURATION_GAMEPLAY_HOMING_ROCKETS_ITEM_SPAWN_PROBABILITY_PERCENTAGE)
+				{
+					// Spawn the item
+					blockContent |= BLOCK_CONTENT_HOMING_ROCKETS;
+					setBlockContent(x, y, blockContent);
+					
+					LOG_DEBUG("Enemy dropped homing rockets.");
+				}
+			}
+		}
+	}
+
+	void increaseBlockEnemiesCount(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int blockIndex;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		// The enemies bit does not stop lines of sight nor belong to the distance fields, so there is nothing else to update
+		blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		_blocksEnemiesCounts[blockIndex]++;
+		_levelBlocks[blockIndex].content |= BLOCK_CONTENT_ENEMY;
+	}
+
+	void decreaseBlockEnemiesCount(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int blockIndex;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		assert(_blocksEnemiesCounts[blockIndex] > 0);
+		_blocksEnemiesCounts[blockIndex]--;
+		if (_blocksEnemiesCounts[blockIndex] == 0) _levelBlocks[blockIndex].content &= ~BLOCK_CONTENT_ENEMY;
+	}
+
+	void addEnemyToBlocks(EnemyFightingEntity *pointerEnemy, SDL_Rect *pointerRectangle)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return;
+		
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++) _enemiesBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)].push_back(pointerEnemy);
+		}
+	}
+
+	void removeEnemyFromBlocks(EnemyFightingEntity *pointerEnemy, SDL_Rect *pointerRectangle)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		unsigned int i;
+		std::vector<EnemyFightingEntity *> *pointerBucket;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return;
+		
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++)
+			{
+				// Buckets are not ordered, so replace the enemy by the last one instead of shifting the bucket content
+				pointerBucket = &_enemiesBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)];
+				for (i = 0; i < pointerBucket->size(); i++)
+				{
+					if ((*pointerBucket)[i] == pointerEnemy)
+					{
+						(*pointerBucket)[i] = pointerBucket->back();
+						pointerBucket->pop_back();
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	void getEnemiesCollidingWithRectangle(SDL_Rect *pointerRectangle, std::vector<EnemyFightingEntity *> *pointerEnemies)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		unsigned int i, j, firstEnemyIndex = pointerEnemies->size();
+		std::vector<EnemyFightingEntity *> *pointerBucket;
+		EnemyFightingEntity *pointerEnemy;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return;
+		
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++)
+			{
+				pointerBucket = &_enemiesBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)];
+				for (i = 0; i < pointerBucket->size(); i++)
+				{
+					pointerEnemy = (*pointerBucket)[i];
+					if (!SDL_HasIntersection(pointerRectangle, pointerEnemy->getPositionRectangle())) continue;
+					
+					// An enemy overlapping several of the tested blocks is found in each of them
+					for (j = firstEnemyIndex; j < pointerEnemies->size(); j++)
+					{
+						if ((*pointerEnemies)[j] == pointerEnemy) break;
+					}
+					if (j == pointerEnemies->size()) pointerEnemies->push_back(pointerEnemy);
+				}
+			}
+		}
+	}
+
+	void getEnemiesInBlocks(SDL_Rect *pointerRectangle, std::vector<EnemyFightingEntity *> *pointerEnemies)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		std::vector<EnemyFightingEntity *> *pointerBucket;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return;
+		
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++)
+			{
+				pointerBucket = &_enemiesBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)];
+				pointerEnemies->insert(pointerEnemies->end(), pointerBucket->begin(), pointerBucket->end());
+			}
+		}
+	}
+
+	EnemySpawnerStaticEntity *getEnemySpawnerCollidingWithRectangle(SDL_Rect *pointerRectangle)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY, collidingEnemySpawnersCount = 0;
+		EnemySpawnerStaticEntity *pointerEnemySpawner, *pointerCollidingEnemySpawner = NULL;
+		std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return NULL;
+		
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++)
+			{
+				pointerEnemySpawner = _enemySpawnersBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)];
+				if ((pointerEnemySpawner != NULL) && SDL_HasIntersection(pointerRectangle, pointerEnemySpawner->getPositionRectangle()))
+				{
+					pointerCollidingEnemySpawner = pointerEnemySpawner;
+					collidingEnemySpawnersCount++;
+				}
+			}
+		}
+		
+		// A rectangle straddling several spawners hits the first one of the spawners list, like a scan of the whole list would do
+		if (collidingEnemySpawnersCount > 1)
+		{
+			for (enemySpawnersListIterator = enemySpawnersList.begin(); enemySpawnersListIterator != enemySpawnersList.end(); ++enemySpawnersListIterator)
+			{
+				pointerEnemySpawner = *enemySpawnersListIterator;
+				if (SDL_HasIntersection(pointerRectangle, pointerEnemySpawner->getPositionRectangle())) return pointerEnemySpawner;
+			}
+		}
+		return pointerCollidingEnemySpawner;
+	}
+
+	void getEnemySpawnersCollidingWithRectangle(SDL_Rect *pointerRectangle, std::vector<EnemySpawnerStaticEntity *> *pointerEnemySpawners)
+	{
+		int x, y, leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		EnemySpawnerStaticEntity *pointerEnemySpawner;
+		
+		if (!_getRectangleBlocks(pointerRectangle, &leftBlockX, &topBlockY, &rightBlockX, &bottomBlockY)) return;
+		
+		// A spawner fills a single block, so it can't be found twice
+		for (y = topBlockY; y <= bottomBlockY; y++)
+		{
+			for (x = leftBlockX; x <= rightBlockX; x++)
+			{
+				pointerEnemySpawner = _enemySpawnersBlocksIndex[COMPUTE_BLOCK_INDEX(x, y)];
+				if ((pointerEnemySpawner != NULL) && SDL_HasIntersection(pointerRectangle, pointerEnemySpawner->getPositionRectangle())) pointerEnemySpawners->push_back(pointerEnemySpawner);
+			}
 		}
 	}
+
+	void removeEnemySpawnerFromBlock(EnemySpawnerStaticEntity *pointerEnemySpawner)
+	{
+		SDL_Rect *pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
+		int xBlock = pointerPositionRectangle->x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = pointerPositionRectangle->y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int blockIndex;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		// Entities can cross the block again
+		blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		_levelBlocks[blockIndex].content &= ~BLOCK_CONTENT_ENEMY_SPAWNER;
+		_updateObstaclesBitmaps(xBlock, yBlock);
+		_changedObstaclesBlocksIndexes.push_back(blockIndex);
+		_updateRowDistanceFields(yBlock);
+		_updateColumnDistanceFields(xBlock);
+		if (_enemySpawnersBlocksIndex[blockIndex] == pointerEnemySpawner) _enemySpawnersBlocksIndex[blockIndex] = NULL;
+	}
 }
@@ -41,14 +41,16 @@ namespace Log
 	
 	void appendMessage(const char *pointerMessageFormat, ...)
 	{
-		// Prepare variable arguments list
-		va_list argumentsList;
+		// Prepare variable arguments list (a copy is needed because the first printing consumes the list on some architectures, like x86_64)
+		va_list argumentsList, argumentsListCopy;
 		va_start(argumentsList, pointerMessageFormat);
+		va_copy(argumentsListCopy, argumentsList);
 		
 		// Append the message
 		vprintf(pointerMessageFormat, argumentsList);
-		vfprintf(_pointerFile, pointerMessageFormat, argumentsList);
+		vfprintf(_pointerFile, pointerMessageFormat, argumentsListCopy);
 		
+		va_end(argumentsListCopy);
 		va_end(argumentsList);
 	}
 }
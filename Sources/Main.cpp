@@ -2,42 +2,116 @@
  * Initialize the game engine and run the game.
  * @author Adrien RICCIARDI
  */
+#include <algorithm>
 #include <AudioManager.hpp>
+#include <Benchmark.hpp>
 #include <BigEnemyFightingEntity.hpp>
+#include <BotManager.hpp>
 #include <BulletMovingEntity.hpp>
+#include <cassert>
+#include <CollisionManager.hpp>
 #include <Configuration.hpp>
 #include <ControlManager.hpp>
 #include <cstdlib>
+#include <climits>
 #include <cstring>
 #include <ctime>
 #include <EnemyFightingEntity.hpp>
 #include <EnemySpawnerStaticEntity.hpp>
 #include <FileManager.hpp>
+#include <GameClock.hpp>
 #include <HeadUpDisplay.hpp>
 #include <list>
 #include <Log.hpp>
+#include <PathfindingManager.hpp>
 #include <LevelManager.hpp>
 #include <MediumEnemyFightingEntity.hpp>
 #include <Menu.hpp>
 #include <PlayerFightingEntity.hpp>
+#include <RandomManager.hpp>
+#include <RectanglesBatch.hpp>
 #include <Renderer.hpp>
+#include <ReplayManager.hpp>
 #include <SavegameManager.hpp>
 #include <SDL2/SDL.h>
 #include <SmallEnemyFightingEntity.hpp>
+#include <Snapshot.hpp>
 #include <TextureManager.hpp>
+#include <vector>
 
-#include <emscripten.h>
+#ifdef __EMSCRIPTEN__
+	#include <emscripten.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The outcome of a headless simulation. */
+typedef struct
+{
+	int executedTicksCount; //!< How many game logic ticks were executed.
+	int levelNumber; //!< The level the simulation stopped in.
+	int playerLifePointsAmount; //!< The player life points when the simulation stopped.
+	bool isPlayerDead; //!< Tell whether the simulation stopped because the player died.
+	bool isGameFinished; //!< Tell whether the simulation stopped because all levels were completed.
+	bool isReplayDiverged; //!< Tell whether the simulation stopped because the played replay diverged from the recorded game.
+	unsigned int worldHash; //!< The world state hash when the simulation stopped, it allows to check that two simulations played the same game.
+} SimulationResult;
+
+/** Describe the sessions the parallel simulation threads share. */
+typedef struct
+{
+	int sessionsCount; //!< How many games to simulate.
+	int ticksCount; //!< The maximum amount of game logic ticks to execute for each session.
+	int startingLevelNumber; //!< The level all sessions start from.
+	unsigned int randomSeed; //!< Session n random numbers streams are seeded with this value plus n.
+	SDL_atomic_t nextSessionIndex; //!< The next session a thread can simulate.
+	SimulationResult *pointerResults; //!< All sessions results, indexed by session number.
+} ParallelSimulationParameters;
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Identify a world snapshot (the value is "SSNP" when read in little endian). */
+static const unsigned int SNAPSHOT_MAGIC = 0x504E5353;
+/** Increment this value each time the world snapshot content changes. */
+static const unsigned int SNAPSHOT_VERSION = 3;
 
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
+// The world state is thread-local, so each headless simulation thread plays its own game. Lists are allocated on first use and never destroyed, because thread-local objects are destroyed before the exit handlers are called
 /** All bullets shot by the player. */
-static std::list<BulletMovingEntity *> _playerBulletsList;
+static thread_local std::list<BulletMovingEntity *> &_playerBulletsList = *new std::list<BulletMovingEntity *>();
 /** All bullets shot by the enemies. */
-static std::list<BulletMovingEntity *> _enemiesBulletsList;
+static thread_local std::list<BulletMovingEntity *> &_enemiesBulletsList = *new std::list<BulletMovingEntity *>();
 
 /** All enemies. */
-static std::list<EnemyFightingEntity *> _enemiesList;
+static thread_local std::list<EnemyFightingEntity *> &_enemiesList = *new std::list<EnemyFightingEntity *>();
+/** The projectiles still alive after they moved, gathered to find what they hit all at once. */
+static thread_local RectanglesBatch &_projectilesRectangles = *new RectanglesBatch();
+/** Where each projectile of _projectilesRectangles is located in its list. */
+static thread_local std::vector<std::list<BulletMovingEntity *>::iterator> &_projectilesIterators = *new std::vector<std::list<BulletMovingEntity *>::iterator>();
+/** Tell whether each projectile of _projectilesRectangles hit a wall or reached its range, so it must be destroyed even if it did not hit an entity. */
+static thread_local std::vector<bool> &_projectilesWallHits = *new std::vector<bool>();
+/** The entities hit by the projectiles being updated. */
+static thread_local std::vector<CollisionManager::Contact> &_projectilesContacts = *new std::vector<CollisionManager::Contact>();
+/** The entities damaged by the projectile explosion being applied. */
+static thread_local std::vector<CollisionManager::QueryResult> &_splashedEntities = *new std::vector<CollisionManager::QueryResult>();
+/** The update order given to the enemy at the enemies list front. */
+static thread_local int _firstEnemyUpdateOrder = 0;
+/** The enemies damaged by the player during the current game logic tick. */
+static thread_local std::vector<EnemyFightingEntity *> &_damagedEnemies = *new std::vector<EnemyFightingEntity *>();
+/** The enemy spawners damaged by the player during the current game logic tick. */
+static thread_local std::vector<EnemySpawnerStaticEntity *> &_damagedEnemySpawners = *new std::vector<EnemySpawnerStaticEntity *>();
+/** The enemies updated during the current game logic tick, in the enemies list order. */
+static thread_local std::vector<EnemyFightingEntity *> &_activeEnemies = *new std::vector<EnemyFightingEntity *>();
+/** The enemy spawners updated during the current game logic tick, in the enemy spawners list order. */
+static thread_local std::vector<EnemySpawnerStaticEntity *> &_activeEnemySpawners = *new std::vector<EnemySpawnerStaticEntity *>();
+/** The enemies killed during the current game logic tick, removed from the enemies list in a single pass once all enemies are updated. */
+static thread_local std::vector<EnemyFightingEntity *> &_killedEnemies = *new std::vector<EnemyFightingEntity *>();
+/** The enemy spawners destroyed during the current game logic tick, removed from the enemy spawners list in a single pass once all enemy spawners are updated. */
+static thread_local std::vector<EnemySpawnerStaticEntity *> &_destroyedEnemySpawners = *new std::vector<EnemySpawnerStaticEntity *>();
 
 /** How many pixels to subtract to the player X coordinate to obtain the scene camera X coordinate. */
 static int _cameraOffsetX;
@@ -45,31 +119,42 @@ static int _cameraOffsetX;
 static int _cameraOffsetY;
 
 /** When set to 1, stop game updating and display a text saying that the player is dead. */
-static bool _isPlayerDead = false;
+static thread_local bool _isPlayerDead = false;
 /** Set to 1 when the player has been hit. */
-static bool _isPlayerHit = false;
+static thread_local bool _isPlayerHit = false;
 
 /** Draw the screen in red if the player has been hit. */
 static Texture *_pointerPlayerHitOverlayTexture;
 
 /** The current level number. */
-static int _currentLevelNumber = 0;
+static thread_local int _currentLevelNumber = 0;
 
 /** When set to 1, stop game updating but continue displaying the scene. */
-static bool _isGamePaused = false;
+static thread_local bool _isGamePaused = false;
 /** Set to 1 when the player has finished all levels. */
-static bool _isGameFinished = false;
+static thread_local bool _isGameFinished = false;
+
+/** The simulation time when enemy spawners generated enemies for the last time. */
+static thread_local unsigned int _lastEnemySpawningTime = 0 - CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN; // Spawn an enemy immediately when the game starts
+
+/** Set to true when the game logic is simulated without any window, renderer, audio or controls. */
+static bool _isHeadlessModeEnabled = false;
+/** Set to true when the bot plays instead of the player. */
+static bool _isBotEnabled = false;
 
 /** The string to display when the player is dead. */
 static SDL_Texture *_pointerGameLostInterfaceStringTexture;
 /** The string to display when the player won the game. */
 static SDL_Texture *_pointerGameWonInterfaceStringTexture;
 
+/** The world saved by the player from the pause menu. */
+static Snapshot _checkpointSnapshot;
+
 //-------------------------------------------------------------------------------------------------
 // Public variables
 //-------------------------------------------------------------------------------------------------
 // The variable must be outside of any namespace
-PlayerFightingEntity *pointerPlayer;
+thread_local PlayerFightingEntity *pointerPlayer;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
@@ -87,7 +172,7 @@ static void _clearAllLists()
 	
 	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) delete *bulletsListIterator;
 	_enemiesBulletsList.clear();
-
+	
 	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
 	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator) delete *enemiesListIterator;
 	_enemiesList.clear();
@@ -107,11 +192,18 @@ static void _exitFreeResources()
 	
 	delete pointerPlayer;
 	
-	ControlManager::uninitialize();
-	AudioManager::uninitialize();
+	// Make sure the whole replay is written to the disk
+	ReplayManager::stopRecording();
+	ReplayManager::stopPlayback();
+	
+	if (!_isHeadlessModeEnabled)
+	{
+		ControlManager::uninitialize();
+		AudioManager::uninitialize();
+	}
 	LevelManager::uninitialize();
 	TextureManager::uninitialize();
-	Renderer::uninitialize();
+	if (!_isHeadlessModeEnabled) Renderer::uninitialize();
 	
 	SDL_Quit();
 	
@@ -179,10 +271,10 @@ static inline EnemyFightingEntity *_spawnEnemy(int enemySpawnerX, int enemySpawn
 	
 	// No room to spawn an enemy
 	return NULL;
-	
+
 Spawn_Enemy:
 	// Select which enemy to spawn
-	spawningPercentage = rand() % 100;
+	spawningPercentage = RandomManager::generateNumber(RandomManager::STREAM_ID_ENEMY_SPAWN, 100);
 	// Start with the smaller percentage and continue so on
 	if (spawningPercentage <= CONFIGURATION_GAMEPLAY_BIG_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new BigEnemyFightingEntity(x, y); // Spawn the enemy on the top-left part of the block, as the enemy size can't be known until it is instantiated
 	else if (spawningPercentage <= CONFIGURATION_GAMEPLAY_MEDIUM_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new MediumEnemyFightingEntity(x, y);
@@ -199,6 +291,114 @@ Spawn_Enemy:
 	return pointerEnemy;
 }
 
+/** Add an enemy to the front of the enemies list.
+ * @param pointerEnemy The enemy to add.
+ */
+static inline void _addEnemy(EnemyFightingEntity *pointerEnemy)
+{
+	_firstEnemyUpdateOrder--;
+	pointerEnemy->setUpdateOrder(_firstEnemyUpdateOrder);
+	_enemiesList.push_front(pointerEnemy);
+}
+
+/** Tell if an enemy comes before another one in the enemies list.
+ * @param pointerFirstEnemy The first enemy to compare.
+ * @param pointerSecondEnemy The second enemy to compare.
+ * @return true if the first enemy must be updated before the second one,
+ * @return false otherwise.
+ */
+static bool _isEnemyUpdatedBefore(EnemyFightingEntity *pointerFirstEnemy, EnemyFightingEntity *pointerSecondEnemy)
+{
+	return pointerFirstEnemy->getUpdateOrder() < pointerSecondEnemy->getUpdateOrder();
+}
+
+/** Tell if an enemy spawner comes before another one in the enemy spawners list, which is filled in the reverse level parsing order.
+ * @param pointerFirstEnemySpawner The first enemy spawner to compare.
+ * @param pointerSecondEnemySpawner The second enemy spawner to compare.
+ * @return true if the first enemy spawner must be updated before the second one,
+ * @return false otherwise.
+ */
+static bool _isEnemySpawnerUpdatedBefore(EnemySpawnerStaticEntity *pointerFirstEnemySpawner, EnemySpawnerStaticEntity *pointerSecondEnemySpawner)
+{
+	if (pointerFirstEnemySpawner->getY() != pointerSecondEnemySpawner->getY()) return pointerFirstEnemySpawner->getY() > pointerSecondEnemySpawner->getY();
+	return pointerFirstEnemySpawner->getX() > pointerSecondEnemySpawner->getX();
+}
+
+/** Tell if an enemy has been killed, so it must be removed from the enemies list.
+ * @param pointerEnemy The enemy.
+ * @return true if the enemy is dead,
+ * @return false otherwise.
+ */
+static bool _isEnemyKilled(EnemyFightingEntity *pointerEnemy)
+{
+	return pointerEnemy->isDead();
+}
+
+/** Tell if an enemy spawner has been destroyed, so it must be removed from the enemy spawners list.
+ * @param pointerEnemySpawner The enemy spawner.
+ * @return true if the enemy spawner has no more life point,
+ * @return false otherwise.
+ */
+static bool _isEnemySpawnerDestroyed(EnemySpawnerStaticEntity *pointerEnemySpawner)
+{
+	return pointerEnemySpawner->getLifePointsAmount() == 0;
+}
+
+/** Damage an enemy, remembering it so it is updated during this tick even if it is far from the player.
+ * @param pointerEnemy The enemy.
+ * @param damageAmount How many life points to remove.
+ */
+static inline void _damageEnemy(EnemyFightingEntity *pointerEnemy, int damageAmount)
+{
+	pointerEnemy->modifyLife(damageAmount);
+	_damagedEnemies.push_back(pointerEnemy);
+}
+
+/** Damage an enemy spawner, remembering it so it is updated during this tick even if it is far from the player.
+ * @param pointerEnemySpawner The enemy spawner.
+ * @param damageAmount How many life points to remove.
+ */
+static inline void _damageEnemySpawner(EnemySpawnerStaticEntity *pointerEnemySpawner, int damageAmount)
+{
+	pointerEnemySpawner->modifyLife(damageAmount);
+	_damagedEnemySpawners.push_back(pointerEnemySpawner);
+}
+
+/** Find the enemies and the enemy spawners to update during this tick. An enemy spots the player only when the player is closer than the display size, so the enemies located further have nothing to do and are not updated, and the enemy spawners located there are paused. The entities damaged by the player are updated wherever they are, so the killed ones are removed at once. */
+static void _findActiveEntities()
+{
+	SDL_Rect *pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle(), activityRectangle;
+	
+	// Cover all the spotting rectangles the player can be in, the level blocks enemies index buckets the enemies by their location
+	activityRectangle.x = pointerPlayerPositionRectangle->x - Renderer::displayWidth - CONFIGURATION_LEVEL_BLOCK_SIZE;
+	activityRectangle.y = pointerPlayerPositionRectangle->y - Renderer::displayHeight - CONFIGURATION_LEVEL_BLOCK_SIZE;
+	activityRectangle.w = pointerPlayerPositionRectangle->w + (2 * (Renderer::displayWidth + CONFIGURATION_LEVEL_BLOCK_SIZE));
+	activityRectangle.h = pointerPlayerPositionRectangle->h + (2 * (Renderer::displayHeight + CONFIGURATION_LEVEL_BLOCK_SIZE));
+	if (activityRectangle.x < 0)
+	{
+		activityRectangle.w += activityRectangle.x;
+		activityRectangle.x = 0;
+	}
+	if (activityRectangle.y < 0)
+	{
+		activityRectangle.h += activityRectangle.y;
+		activityRectangle.y = 0;
+	}
+	
+	// Update the enemies in the enemies list order, like when all of them were updated
+	_activeEnemies.assign(_damagedEnemies.begin(), _damagedEnemies.end());
+	_damagedEnemies.clear();
+	LevelManager::getEnemiesInBlocks(&activityRectangle, &_activeEnemies);
+	std::sort(_activeEnemies.begin(), _activeEnemies.end(), _isEnemyUpdatedBefore);
+	_activeEnemies.erase(std::unique(_activeEnemies.begin(), _activeEnemies.end()), _activeEnemies.end());
+	
+	_activeEnemySpawners.assign(_damagedEnemySpawners.begin(), _damagedEnemySpawners.end());
+	_damagedEnemySpawners.clear();
+	LevelManager::getEnemySpawnersCollidingWithRectangle(&activityRectangle, &_activeEnemySpawners);
+	std::sort(_activeEnemySpawners.begin(), _activeEnemySpawners.end(), _isEnemySpawnerUpdatedBefore);
+	_activeEnemySpawners.erase(std::unique(_activeEnemySpawners.begin(), _activeEnemySpawners.end()), _activeEnemySpawners.end());
+}
+
 /** Load next level. */
 static inline void _loadNextLevel()
 {
@@ -223,119 +423,176 @@ static inline void _loadNextLevel()
 		exit(-1);
 	}
 	
-	// Save player progress
-	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_STARTING_LEVEL, _currentLevelNumber);
-	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS, pointerPlayer->getMaximumLifePointsAmount());
-	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION, pointerPlayer->getAmmunitionAmount());
-	SavegameManager::storeSavegame();
-	LOG_DEBUG("Saved game.");
+	// Save player progress (a simulation must not overwrite the player savegame)
+	if (!_isHeadlessModeEnabled)
+	{
+		SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_STARTING_LEVEL, _currentLevelNumber);
+		SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS, pointerPlayer->getMaximumLifePointsAmount());
+		SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION, pointerPlayer->getAmmunitionAmount());
+		SavegameManager::storeSavegame();
+		LOG_DEBUG("Saved game.");
+	}
 	
 	// Prepare to load next level
 	_currentLevelNumber++;
 }
 
-/** Update all game actors. */
-static inline void _updateGameLogic()
+/** Damage the enemies and the enemy spawners around an exploding projectile, if the projectile explodes.
+ * @param pointerProjectile The projectile, its center is the explosion center.
+ * @param pointerHitEntity The entity the projectile hit, which already received the projectile damage (it can be NULL).
+ */
+static void _applySplashDamage(BulletMovingEntity *pointerProjectile, Entity *pointerHitEntity)
 {
-	static unsigned int lastEnemySpawningTime = -CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN; // Initialize to a negative value (gcc allows it) to spawn an enemy immediately when the game starts
+	SDL_Rect *pointerPositionRectangle;
+	CollisionManager::QueryResult *pointerResult;
+	unsigned int i;
 	
-	// Check if pickable objects can be taken by the player or if the level end has been reached
-	if (pointerPlayer->update() == 2)
+	if (pointerProjectile->getSplashRadius() <= 0) return;
+	
+	pointerPositionRectangle = pointerProjectile->getPositionRectangle();
+	CollisionManager::queryRadius(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2), pointerPositionRectangle->y + (pointerPositionRectangle->h / 2), pointerProjectile->getSplashRadius(), COLLISION_MANAGER_LAYER_BIT(CollisionManager::LAYER_ENEMY) | COLLISION_MANAGER_LAYER_BIT(CollisionManager::LAYER_ENEMY_SPAWNER), &_splashedEntities);
+	for (i = 0; i < _splashedEntities.size(); i++)
 	{
-		// Next level can be loaded only if all enemies are dead and all spawners are destroyed
-		if (_enemiesList.empty() && LevelManager::enemySpawnersList.empty())
-		{
-			// Restore player maximum life
-			pointerPlayer->modifyLife(pointerPlayer->getMaximumLifePointsAmount());
-			
-			_loadNextLevel();
-			return;
-		}
+		pointerResult = &_splashedEntities[i];
+		if (pointerResult->pointerEntity == pointerHitEntity) continue;
+		
+		if (pointerResult->layer == CollisionManager::LAYER_ENEMY) _damageEnemy(static_cast<EnemyFightingEntity *>(pointerResult->pointerEntity), pointerProjectile->getSplashDamageAmount());
+		else _damageEnemySpawner(static_cast<EnemySpawnerStaticEntity *>(pointerResult->pointerEntity), pointerProjectile->getSplashDamageAmount());
+	}
+}
+
+/** Move projectiles, apply the damages of the ones that hit an entity of the layers their layer collides with, then remove the ones that hit a wall.
+ * @param pointerProjectilesList The projectiles to update.
+ * @param projectilesLayer The collision layer all the list projectiles belong to.
+ * @return 0 if the game can continue,
+ * @return 1 if the player died (the remaining hits are not applied).
+ */
+static int _updateProjectiles(std::list<BulletMovingEntity *> *pointerProjectilesList, CollisionManager::Layer projectilesLayer)
+{
+	std::list<BulletMovingEntity *>::iterator projectilesListIterator;
+	BulletMovingEntity *pointerProjectile;
+	CollisionManager::Contact *pointerContact;
+	EffectManager::EffectId effectId;
+	unsigned int i, contactIndex = 0;
+	
+	// Move all projectiles, the ones that hit a wall are tested against the entities too, because they may have crossed an entity before reaching the wall
+	_projectilesRectangles.clear();
+	_projectilesIterators.clear();
+	_projectilesWallHits.clear();
+	for (projectilesListIterator = pointerProjectilesList->begin(); projectilesListIterator != pointerProjectilesList->end(); ++projectilesListIterator)
+	{
+		pointerProjectile = *projectilesListIterator;
+		_projectilesWallHits.push_back(pointerProjectile->update() != 0);
+		
+		// Test the whole area the projectile went through, so fast projectiles can't cross small entities
+		_projectilesRectangles.add(pointerProjectile->getSweptRectangle());
+		_projectilesIterators.push_back(projectilesListIterator);
 	}
 	
-	// Check if player bullets have hit a wall or an enemy
-	std::list<BulletMovingEntity *>::iterator bulletsListIterator = _playerBulletsList.begin();
-	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
-	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
-	BulletMovingEntity *pointerPlayerBullet;
-	EnemyFightingEntity *pointerEnemy;
-	EnemySpawnerStaticEntity *pointerEnemySpawner;
-	while (bulletsListIterator != _playerBulletsList.end())
+	// Apply the hits and remove the destroyed projectiles in the projectiles order
+	CollisionManager::findContacts(projectilesLayer, &_projectilesRectangles, &_projectilesContacts);
+	for (i = 0; i < _projectilesIterators.size(); i++)
 	{
-		pointerPlayerBullet = *bulletsListIterator;
+		projectilesListIterator = _projectilesIterators[i];
+		pointerProjectile = *projectilesListIterator;
 		
-		// Remove the bullet if it hit a wall
-		if (pointerPlayerBullet->update() != 0)
+		// Contacts are sorted by projectile index
+		if ((contactIndex < _projectilesContacts.size()) && (_projectilesContacts[contactIndex].projectileIndex == (int) i))
 		{
-			EffectManager::addEffect(pointerPlayerBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerPlayerBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND);
+			pointerContact = &_projectilesContacts[contactIndex];
+			contactIndex++;
+		}
+		else
+		{
+			// Keep the projectile if it did not hit anything
+			if (!_projectilesWallHits[i]) continue;
+			
+			EffectManager::addEffect(pointerProjectile->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerProjectile->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND);
+			_applySplashDamage(pointerProjectile, NULL);
 			
-			delete pointerPlayerBullet;
-			bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
+			delete pointerProjectile;
+			pointerProjectilesList->erase(projectilesListIterator);
 			continue;
 		}
 		
-		// Check with all enemies for a collision
-		for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator)
+		switch (pointerContact->layer)
 		{
-			pointerEnemy = *enemiesListIterator;
-			
-			// Did the bullet hit this enemy ?
-			if (SDL_HasIntersection(pointerPlayerBullet->getPositionRectangle(), pointerEnemy->getPositionRectangle()))
-			{
-				// Wound the enemy
-				pointerEnemy->modifyLife(pointerPlayerBullet->getDamageAmount());
+			case CollisionManager::LAYER_ENEMY:
+				_damageEnemy(static_cast<EnemyFightingEntity *>(pointerContact->pointerEntity), pointerProjectile->getDamageAmount());
 				LOG_DEBUG("Enemy hit.");
-				
-				EffectManager::addEffect(pointerPlayerBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerPlayerBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_ENEMY_HIT);
-				
-				// Remove the bullet
-				delete pointerPlayerBullet;
-				bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
-				
+				effectId = EffectManager::EFFECT_ID_BULLET_EXPLOSION_ENEMY_HIT;
 				break;
-			}
-		}
-		
-		// The bullet collided an enemy and was destroyed, check next bullet
-		if (enemiesListIterator != _enemiesList.end()) continue;
-		
-		// Check with all spawners for a collision
-		for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
-		{
-			pointerEnemySpawner = *enemySpawnersListIterator;
 			
-			if (SDL_HasIntersection(pointerPlayerBullet->getPositionRectangle(), pointerEnemySpawner->getPositionRectangle()))
-			{
-				// Damage the enemy spawner
-				pointerEnemySpawner->modifyLife(pointerPlayerBullet->getDamageAmount());
+			case CollisionManager::LAYER_ENEMY_SPAWNER:
+				_damageEnemySpawner(static_cast<EnemySpawnerStaticEntity *>(pointerContact->pointerEntity), pointerProjectile->getDamageAmount());
 				LOG_DEBUG("Enemy spawner hit.");
-				
-				EffectManager::addEffect(pointerPlayerBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerPlayerBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_ENEMY_SPAWNER_HIT);
-				
-				// Remove the bullet
-				delete pointerPlayerBullet;
-				bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
-				
+				effectId = EffectManager::EFFECT_ID_BULLET_EXPLOSION_ENEMY_SPAWNER_HIT;
 				break;
-			}
+			
+			case CollisionManager::LAYER_PLAYER:
+				_isPlayerHit = pointerPlayer->modifyLife(pointerProjectile->getDamageAmount());
+				if (_isPlayerHit) LOG_DEBUG("Player hit.");
+				effectId = EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND;
+				break;
+			
+			default:
+				assert(false); // Projectiles can't hit other projectiles
+				continue;
 		}
+		EffectManager::addEffect(pointerProjectile->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerProjectile->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, effectId);
+		_applySplashDamage(pointerProjectile, pointerContact->pointerEntity);
 		
-		// The bullet collided an enemy spawner and was destroyed, check next bullet
-		if (enemySpawnersListIterator != LevelManager::enemySpawnersList.end()) continue;
+		// Remove the projectile
+		delete pointerProjectile;
+		pointerProjectilesList->erase(projectilesListIterator);
 		
-		// The bullet is still alive, check next one
-		++bulletsListIterator;
+		// Instantly stop game updating
+		if ((pointerContact->layer == CollisionManager::LAYER_PLAYER) && pointerPlayer->isDead())
+		{
+			_isPlayerDead = true;
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+/** Update all game actors. */
+static inline void _updateGameLogic()
+{
+	// Check if pickable objects can be taken by the player or if the level end has been reached
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_PLAYER);
+	if (pointerPlayer->update() == 2)
+	{
+		// Next level can be loaded only if all enemies are dead and all spawners are destroyed
+		if (_enemiesList.empty() && LevelManager::enemySpawnersList.empty())
+		{
+			// Restore player maximum life
+			pointerPlayer->modifyLife(pointerPlayer->getMaximumLifePointsAmount());
+			
+			_loadNextLevel();
+			return;
+		}
 	}
 	
+	// Check if player bullets have hit a wall, an enemy or an enemy spawner
+	EnemyFightingEntity *pointerEnemy;
+	EnemySpawnerStaticEntity *pointerEnemySpawner;
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_PLAYER_BULLETS);
+	_updateProjectiles(&_playerBulletsList, CollisionManager::LAYER_PLAYER_PROJECTILE);
+	
 	// Update enemies artificial intelligence
 	BulletMovingEntity *pointerBullet;
 	int result;
 	int previousEnemiesAmount = _enemiesList.size();
 	SDL_Rect *pointerPositionRectangle;
-	enemiesListIterator = _enemiesList.begin();
-	while (enemiesListIterator != _enemiesList.end())
+	unsigned int i;
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_ENEMIES);
+	PathfindingManager::update(); // All enemies share the same way to the player
+	_findActiveEntities(); // Only the entities close to the player are updated
+	for (i = 0; i < _activeEnemies.size(); i++)
 	{
-		pointerEnemy = *enemiesListIterator;
+		pointerEnemy = _activeEnemies[i];
 		
 		result = pointerEnemy->update();
 		// Remove the enemy if it is dead
@@ -345,11 +602,8 @@ static inline void _updateGameLogic()
 			pointerPositionRectangle = pointerEnemy->getPositionRectangle();
 			LevelManager::spawnItem(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2), pointerPositionRectangle->y + (pointerPositionRectangle->h / 2)); // Use enemy center coordinates to avoid favoring one block among others
 			
-			// Remove the enemy
-			delete pointerEnemy;
-			enemiesListIterator = _enemiesList.erase(enemiesListIterator);
-			
-			continue;
+			// Remove the enemy once all enemies are updated
+			_killedEnemies.push_back(pointerEnemy);
 		}
 		// The enemy wants to shoot
 		else if (result == 2)
@@ -358,100 +612,70 @@ static inline void _updateGameLogic()
 			pointerBullet = pointerEnemy->shoot();
 			if (pointerBullet != NULL) _enemiesBulletsList.push_front(pointerBullet);
 		}
-		
-		// Enemy is still alive, check next one
-		++enemiesListIterator;
 	}
 	
-	// Check if enemies bullets have hit the player (update enemies bullets after enemies, so if they shot a new bullet is it updated too, in the same way it's done for the player. Thus, it is possible to adjust bullet spawning coordinate offsets in the same way for player and enemies)
-	BulletMovingEntity *pointerEnemyBullet;
-	bulletsListIterator = _enemiesBulletsList.begin();
-	pointerPositionRectangle = pointerPlayer->getPositionRectangle();
-	while (bulletsListIterator != _enemiesBulletsList.end())
+	// Remove all killed enemies with a single list traversal, looking each one up in the list would cost a traversal per enemy
+	if (!_killedEnemies.empty())
 	{
-		pointerEnemyBullet = *bulletsListIterator;
-		
-		// Remove the bullet if it hit a wall
-		if (pointerEnemyBullet->update() != 0)
-		{
-			EffectManager::addEffect(pointerEnemyBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerEnemyBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND);
-			
-			delete pointerEnemyBullet;
-			bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
-			continue;
-		}
-		
-		if (SDL_HasIntersection(pointerPositionRectangle, pointerEnemyBullet->getPositionRectangle()))
-		{
-			// Wound the player
-			_isPlayerHit = pointerPlayer->modifyLife(pointerEnemyBullet->getDamageAmount());
-			if (_isPlayerHit) LOG_DEBUG("Player hit.");
-			
-			EffectManager::addEffect(pointerEnemyBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerEnemyBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND);
-			
-			// Remove the bullet
-			delete pointerEnemyBullet;
-			bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
-			
-			// Instantly stop game updating
-			if (pointerPlayer->isDead())
-			{
-				_isPlayerDead = true;
-				_isGamePaused = true; // Pause game updating
-				LOG_DEBUG("Player died.");
-				return;
-			}
-			continue;
-		}
-		
-		// Bullet is still alive, check next one
-		++bulletsListIterator;
+		_enemiesList.remove_if(_isEnemyKilled);
+		for (i = 0; i < _killedEnemies.size(); i++) delete _killedEnemies[i];
+		_killedEnemies.clear();
+	}
+	
+	// Move enemies bullets (update enemies bullets after enemies, so if they shot a new bullet is it updated too, in the same way it's done for the player. Thus, it is possible to adjust bullet spawning coordinate offsets in the same way for player and enemies)
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_ENEMIES_BULLETS);
+	if (_updateProjectiles(&_enemiesBulletsList, CollisionManager::LAYER_ENEMY_PROJECTILE) != 0)
+	{
+		_isGamePaused = true; // Pause game updating
+		LOG_DEBUG("Player died.");
+		return;
 	}
 	
 	// Update enemy spawners at the end, to avoid new enemies being spawned in the middle of the update function
-	int blockContent, isEnemySpawned = 0;
-	enemySpawnersListIterator = LevelManager::enemySpawnersList.begin();
+	int isEnemySpawned = 0;
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_ENEMY_SPAWNERS);
 	// Should enemies be spawned ?
-	if (SDL_GetTicks() - lastEnemySpawningTime >= CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN)
+	if (GameClock::getTime() - _lastEnemySpawningTime >= CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN)
 	{
-		lastEnemySpawningTime = SDL_GetTicks();
+		_lastEnemySpawningTime = GameClock::getTime();
 		isEnemySpawned = 1;
 	}
-	while (enemySpawnersListIterator !=  LevelManager::enemySpawnersList.end())
+	for (i = 0; i < _activeEnemySpawners.size(); i++)
 	{
-		pointerEnemySpawner = *enemySpawnersListIterator;
+		pointerEnemySpawner = _activeEnemySpawners[i];
 		
 		// Remove the spawner if it is destroyed
 		if (pointerEnemySpawner->update() == 1)
 		{
 			// Remove the spawner indicator from the block
+			LevelManager::removeEnemySpawnerFromBlock(pointerEnemySpawner);
 			pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
-			blockContent = LevelManager::getBlockContent(pointerPositionRectangle->x, pointerPositionRectangle->y);
-			blockContent &= ~LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER;
-			LevelManager::setBlockContent(pointerPositionRectangle->x, pointerPositionRectangle->y, blockContent);
 			
 			// Display an explosion
 			EffectManager::addEffect(pointerPositionRectangle->x, pointerPositionRectangle->y, EffectManager::EFFECT_ID_ENEMY_SPAWNER_EXPLOSION);
 			
-			// Remove the spawner
-			delete pointerEnemySpawner;
-			enemySpawnersListIterator = LevelManager::enemySpawnersList.erase(enemySpawnersListIterator);
-			
-			continue;
+			// Remove the spawner once all spawners are updated
+			_destroyedEnemySpawners.push_back(pointerEnemySpawner);
 		}
 		// Try to spawn an enemy if the spawner is still alive and enough time has elapsed since last spawn
 		else if (isEnemySpawned)
 		{
 			pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
 			pointerEnemy = _spawnEnemy(pointerPositionRectangle->x, pointerPositionRectangle->y);
-			if (pointerEnemy != NULL) _enemiesList.push_front(pointerEnemy);
+			if (pointerEnemy != NULL) _addEnemy(pointerEnemy);
 		}
-		
-		// Spawner is still working, check next one
-		++enemySpawnersListIterator;
+	}
+	
+	// Remove all destroyed spawners with a single list traversal
+	if (!_destroyedEnemySpawners.empty())
+	{
+		LevelManager::enemySpawnersList.remove_if(_isEnemySpawnerDestroyed);
+		for (i = 0; i < _destroyedEnemySpawners.size(); i++) delete _destroyedEnemySpawners[i];
+		_destroyedEnemySpawners.clear();
 	}
 	
 	// Update effects at the end because they can be spawned by previous updates
+	BENCHMARK_BEGIN_PHASE(PHASE_ID_EFFECTS);
 	EffectManager::update();
 	
 	// Update HUD enemies count if changed
@@ -459,94 +683,903 @@ static inline void _updateGameLogic()
 	if (currentEnemiesAmount != previousEnemiesAmount) HeadUpDisplay::setEnemiesAmount(currentEnemiesAmount);
 }
 
-/** Display and keep up to date interface strings. */
-static inline void _renderInterface()
+/** Move the player and make it shoot according to the pressed keys. */
+static inline void _handlePlayerControls()
 {
-	// Turn off all compass arrows, so only the appropriate ones will be lighted
-	for (int i = 0; i < HeadUpDisplay::COMPASS_ARROW_IDS_COUNT; i++) HeadUpDisplay::setCompassArrowState(static_cast<HeadUpDisplay::CompassArrowId>(i), false);
+	BulletMovingEntity *pointerBullet;
 	
-	// Detect enemy spawners positions against player to light the corresponding compass arrows
-	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
-	EnemySpawnerStaticEntity *pointerSpawner;
-	int playerBlockX = pointerPlayer->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-	int playerBlockY = pointerPlayer->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-	int spawnerBlockX, spawnerBlockY;
-	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
+	// React to player key press without depending of keyboard key repetition rate
+	// Handle both vertical and horizontal direction movement
+	if ((ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) && (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)))
 	{
-		// Compute spawner block position
-		pointerSpawner = *enemySpawnersListIterator;
-		spawnerBlockX = pointerSpawner->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		spawnerBlockY = pointerSpawner->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Is the spawner above the player ?
-		if (spawnerBlockY < playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_UP, true);
-		else if (spawnerBlockY > playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_DOWN, true);
-		
-		// Is the spawner on the player left ?
-		if (spawnerBlockX < playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_LEFT, true);
-		else if (spawnerBlockX > playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_RIGHT, true);
+		// Keep trace of the last direction the player took to favor it, when this key will be released the previous direction will be favored
+		if (ControlManager::isLastPressedDirectionKeyOnVerticalAxis())
+		{
+			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
+			else pointerPlayer->moveToDown();
+		}
+		else
+		{
+			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
+			else pointerPlayer->moveToRight();
+		}
+	}
+	// Handle a single key press
+	else
+	{
+		if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) pointerPlayer->moveToDown();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)) pointerPlayer->moveToRight();
 	}
 	
-	HeadUpDisplay::render();
+	// Fire a bullet
+	if (ControlManager::isKeyPressed(ControlManager::KEY_ID_PRIMARY_SHOOT))
+	{
+		// Is the player allowed to shoot ?
+		pointerBullet = pointerPlayer->shoot();
+		if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
+	}
+	// Fire a mortar shell (bullet and mortar shell can be shot in the same time)
+	if (ControlManager::isKeyPressed(ControlManager::KEY_ID_SECONDARY_SHOOT))
+	{
+		// Is the player allowed to shoot ?
+		pointerBullet = pointerPlayer->shootSecondaryFire();
+		if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
+	}
+}
+
+/** Keep the position all moving entities had before the game logic tick that is going to be executed, so they can be rendered between two ticks. */
+static inline void _saveMovingEntitiesPreviousPositions()
+{
+	pointerPlayer->savePreviousPosition();
 	
-	// Display a centered message if needed
-	if (_isPlayerDead) Renderer::renderCenteredTexture(_pointerGameLostInterfaceStringTexture);
-	else if (_isGameFinished) Renderer::renderCenteredTexture(_pointerGameWonInterfaceStringTexture);
+	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator) (*enemiesListIterator)->savePreviousPosition();
+	
+	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
+	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->savePreviousPosition();
+	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->savePreviousPosition();
 }
 
-/** Display everything to the screen. */
-static inline void _renderGame()
+/** Mix a value into a FNV-1a hash.
+ * @param hash The hash computed so far.
+ * @param value The value to add to the hash.
+ * @return The new hash value.
+ */
+static inline unsigned int _hashValue(unsigned int hash, unsigned int value)
 {
-	// Compute rendering top left coordinates
-	int sceneX = pointerPlayer->getX() - _cameraOffsetX;
-	int sceneY = pointerPlayer->getY() - _cameraOffsetY;
-	Renderer::displayX = sceneX;
-	Renderer::displayY = sceneY;
+	for (int i = 0; i < 4; i++)
+	{
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 16777619U; // FNV prime
+	}
+	return hash;
+}
+
+/** Mix an entity position and size into a FNV-1a hash.
+ * @param hash The hash computed so far.
+ * @param pointerPositionRectangle The entity position rectangle.
+ * @return The new hash value.
+ */
+static inline unsigned int _hashPositionRectangle(unsigned int hash, SDL_Rect *pointerPositionRectangle)
+{
+	hash = _hashValue(hash, pointerPositionRectangle->x);
+	hash = _hashValue(hash, pointerPositionRectangle->y);
+	hash = _hashValue(hash, pointerPositionRectangle->w);
+	return _hashValue(hash, pointerPositionRectangle->h);
+}
+
+/** Compute a value summarizing the whole world state, so two games can be compared tick by tick.
+ * @return The world state hash.
+ */
+static unsigned int _computeWorldHash()
+{
+	unsigned int hash = 2166136261U; // FNV offset basis
 	
-	// Render the level walls and static objects (ammunition, medipacks, ...)
-	LevelManager::renderScene(sceneX, sceneY);
+	hash = _hashValue(hash, GameClock::getTime());
+	hash = _hashValue(hash, _currentLevelNumber);
 	
-	// Display enemy spawners
-	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
-	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator) (*enemySpawnersListIterator)->render();
+	// Player
+	hash = _hashPositionRectangle(hash, pointerPlayer->getPositionRectangle());
+	hash = _hashValue(hash, pointerPlayer->getLifePointsAmount());
+	hash = _hashValue(hash, pointerPlayer->getMaximumLifePointsAmount());
+	hash = _hashValue(hash, pointerPlayer->getAmmunitionAmount());
 	
-	// Display enemies
+	// Enemies
 	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
-	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator) (*enemiesListIterator)->render();
+	hash = _hashValue(hash, _enemiesList.size());
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator)
+	{
+		hash = _hashPositionRectangle(hash, (*enemiesListIterator)->getPositionRectangle());
+		hash = _hashValue(hash, (*enemiesListIterator)->getLifePointsAmount());
+	}
 	
-	// Display bullets after enemies, so when multiple enemies fire on themselves bullets are visible on top of enemies
+	// Bullets
 	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
-	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
-	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
-	
-	// Display the player now, so it is always rendered on top on everything else and can always be visible
-	pointerPlayer->render();
-	
-	// Display special effects at the end, so they can recover everything
-	EffectManager::render();
+	hash = _hashValue(hash, _playerBulletsList.size());
+	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator) hash = _hashPositionRectangle(hash, (*bulletsListIterator)->getPositionRectangle());
+	hash = _hashValue(hash, _enemiesBulletsList.size());
+	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) hash = _hashPositionRectangle(hash, (*bulletsListIterator)->getPositionRectangle());
 	
-	// Display the red overlay
-	if (_isPlayerHit)
+	// Enemy spawners
+	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+	hash = _hashValue(hash, LevelManager::enemySpawnersList.size());
+	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
 	{
-		SDL_RenderCopy(Renderer::pointerRenderer, _pointerPlayerHitOverlayTexture->getSDLTexture(), NULL, NULL);
-		_isPlayerHit = false;
+		hash = _hashPositionRectangle(hash, (*enemySpawnersListIterator)->getPositionRectangle());
+		hash = _hashValue(hash, (*enemySpawnersListIterator)->getLifePointsAmount());
 	}
 	
-	// Display HUD
-	_renderInterface();
+	return hash;
 }
 
-//-------------------------------------------------------------------------------------------------
-// Entry point
-//-------------------------------------------------------------------------------------------------
-int main(int argc, char *argv[])
+/** Store the whole world state (level blocks and every entity with its timers, player statistics, simulation time and random numbers streams).
+ * @param pointerSnapshot On output, contain the world state. The previous content is discarded.
+ */
+static void _saveWorld(Snapshot *pointerSnapshot)
+{
+	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
+	
+	pointerSnapshot->beginWriting();
+	
+	// Header
+	pointerSnapshot->writeUnsignedInteger(SNAPSHOT_MAGIC);
+	pointerSnapshot->writeUnsignedInteger(SNAPSHOT_VERSION);
+	pointerSnapshot->writeInteger(Renderer::displayWidth);
+	pointerSnapshot->writeInteger(Renderer::displayHeight);
+	
+	// Game progress
+	pointerSnapshot->writeInteger(LevelManager::getLoadedLevelNumber());
+	pointerSnapshot->writeInteger(_currentLevelNumber);
+	pointerSnapshot->writeInteger(_isPlayerDead);
+	pointerSnapshot->writeInteger(_isGamePaused);
+	pointerSnapshot->writeInteger(_isGameFinished);
+	pointerSnapshot->writeUnsignedInteger(_lastEnemySpawningTime);
+	pointerSnapshot->writeUnsignedInteger(GameClock::getTime());
+	RandomManager::saveState(pointerSnapshot);
+	
+	// Entities
+	pointerPlayer->saveState(pointerSnapshot);
+	
+	pointerSnapshot->writeInteger(_enemiesList.size());
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator)
+	{
+		pointerSnapshot->writeInteger((*enemiesListIterator)->getType());
+		(*enemiesListIterator)->saveState(pointerSnapshot);
+	}
+	
+	pointerSnapshot->writeInteger(_playerBulletsList.size());
+	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator)
+	{
+		pointerSnapshot->writeInteger((*bulletsListIterator)->getTextureId());
+		(*bulletsListIterator)->saveState(pointerSnapshot);
+	}
+	pointerSnapshot->writeInteger(_enemiesBulletsList.size());
+	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator)
+	{
+		pointerSnapshot->writeInteger((*bulletsListIterator)->getTextureId());
+		(*bulletsListIterator)->saveState(pointerSnapshot);
+	}
+	
+	EffectManager::saveState(pointerSnapshot);
+	BotManager::saveState(pointerSnapshot);
+	
+	// Store the level last, because enemies mark the blocks they are created on, so blocks content must be restored after them
+	LevelManager::saveState(pointerSnapshot);
+}
+
+/** Create again all bullets of a list stored in a snapshot.
+ * @param pointerSnapshot The snapshot to read from.
+ * @param pointerBulletsList The empty list to add the bullets to.
+ * @return 0 if the bullets were restored,
+ * @return -1 if the snapshot is corrupted.
+ */
+static int _restoreBullets(Snapshot *pointerSnapshot, std::list<BulletMovingEntity *> *pointerBulletsList)
 {
-	SDL_Event event;
-	unsigned int frameRateStartingTime = 0;
-	bool isFullScreenEnabled = true, isFramesPerSecondDisplayingEnabled = true;
-	isFullScreenEnabled = false;
-	int levelToLoadNumber, i, framesCount = 0;
 	BulletMovingEntity *pointerBullet;
+	int i, bulletsCount, textureId;
+	
+	bulletsCount = pointerSnapshot->readInteger();
+	for (i = 0; (i < bulletsCount) && !pointerSnapshot->isReadingFailed(); i++)
+	{
+		textureId = pointerSnapshot->readInteger();
+		if ((textureId < 0) || (textureId > TextureManager::TEXTURE_IDS_COUNT - MovingEntity::DIRECTIONS_COUNT)) return -1; // The bullet uses four consecutive textures
+		
+		// Speed, direction, damage and collisions are restored from the snapshot
+		pointerBullet = new BulletMovingEntity(0, 0, (TextureManager::TextureId) textureId, 0, MovingEntity::DIRECTION_UP, 0, false);
+		pointerBullet->restoreState(pointerSnapshot);
+		pointerBulletsList->push_back(pointerBullet);
+	}
+	
+	return 0;
+}
+
+/** Replace the whole world by the one stored in a snapshot. The level the snapshot was taken from is loaded if it is not the current one, otherwise restoring does not access any file.
+ * @param pointerSnapshot The snapshot created by _saveWorld().
+ * @return 0 if the world was restored,
+ * @return -1 if the snapshot is not a valid world snapshot or was saved by another game version (the world is left unchanged),
+ * @return -2 if the snapshot is corrupted (the world is left in an undefined state, the level must be reloaded).
+ */
+static int _restoreWorld(Snapshot *pointerSnapshot)
+{
+	int i, displayWidth, displayHeight, loadedLevelNumber, enemiesCount;
+	unsigned int version;
+	EnemyFightingEntity *pointerEnemy;
+	Uint64 startingTime = SDL_GetPerformanceCounter();
+	
+	pointerSnapshot->beginReading();
+	
+	// Make sure this is a snapshot this game version can restore
+	if (pointerSnapshot->readUnsignedInteger() != SNAPSHOT_MAGIC)
+	{
+		LOG_ERROR("The data is not a world snapshot.");
+		return -1;
+	}
+	version = pointerSnapshot->readUnsignedInteger();
+	if (version != SNAPSHOT_VERSION)
+	{
+		LOG_ERROR("World snapshot version %u is not supported (expected version %u).", version, SNAPSHOT_VERSION);
+		return -1;
+	}
+	
+	// Entities behavior depends on the display size, the world is restored anyway because this only matters for replays
+	displayWidth = pointerSnapshot->readInteger();
+	displayHeight = pointerSnapshot->readInteger();
+	if ((displayWidth != Renderer::displayWidth) || (displayHeight != Renderer::displayHeight)) LOG_ERROR("The display size (%dx%d) differs from the snapshot one (%dx%d), enemies will not behave exactly the same.", Renderer::displayWidth, Renderer::displayHeight, displayWidth, displayHeight);
+	
+	loadedLevelNumber = pointerSnapshot->readInteger();
+	if ((loadedLevelNumber < 0) || (loadedLevelNumber >= CONFIGURATION_LEVELS_COUNT))
+	{
+		LOG_ERROR("World snapshot level number is bad : %d.", loadedLevelNumber);
+		return -1;
+	}
+	
+	// The replay does not describe the game anymore
+	ReplayManager::stopRecording();
+	ReplayManager::stopPlayback();
+	
+	// Free all entities
+	AudioManager::stopAllSounds();
+	_clearAllLists();
+	
+	// Parse the level files only when another level is needed
+	if (LevelManager::getLoadedLevelNumber() != loadedLevelNumber)
+	{
+		if (LevelManager::loadLevel(loadedLevelNumber) != 0)
+		{
+			LOG_ERROR("Failed to load snapshot level %d.", loadedLevelNumber);
+			return -2;
+		}
+		_clearAllLists(); // Remove the enemy spawners the level spawned, they are restored later
+	}
+	
+	// Game progress
+	_currentLevelNumber = pointerSnapshot->readInteger();
+	_isPlayerDead = pointerSnapshot->readInteger();
+	_isGamePaused = pointerSnapshot->readInteger();
+	_isGameFinished = pointerSnapshot->readInteger();
+	_lastEnemySpawningTime = pointerSnapshot->readUnsignedInteger();
+	GameClock::setTime(pointerSnapshot->readUnsignedInteger());
+	RandomManager::restoreState(pointerSnapshot);
+	
+	// Entities
+	pointerPlayer->restoreState(pointerSnapshot);
+	
+	enemiesCount = pointerSnapshot->readInteger();
+	for (i = 0; (i < enemiesCount) && !pointerSnapshot->isReadingFailed(); i++)
+	{
+		// Create the right enemy class, its position and state are restored from the snapshot
+		switch (pointerSnapshot->readInteger())
+		{
+			case EnemyFightingEntity::ENEMY_TYPE_SMALL:
+				pointerEnemy = new SmallEnemyFightingEntity(0, 0);
+				break;
+			
+			case EnemyFightingEntity::ENEMY_TYPE_MEDIUM:
+				pointerEnemy = new MediumEnemyFightingEntity(0, 0);
+				break;
+			
+			case EnemyFightingEntity::ENEMY_TYPE_BIG:
+				pointerEnemy = new BigEnemyFightingEntity(0, 0);
+				break;
+			
+			default:
+				LOG_ERROR("World snapshot enemy %d type is bad.", i);
+				return -2;
+		}
+		pointerEnemy->restoreState(pointerSnapshot);
+		pointerEnemy->setUpdateOrder(i); // Only the enemies order matters
+		_enemiesList.push_back(pointerEnemy);
+	}
+	
+	if ((_restoreBullets(pointerSnapshot, &_playerBulletsList) != 0) || (_restoreBullets(pointerSnapshot, &_enemiesBulletsList) != 0))
+	{
+		LOG_ERROR("World snapshot bullets are corrupted.");
+		return -2;
+	}
+	
+	if (EffectManager::restoreState(pointerSnapshot) != 0) return -2;
+	BotManager::restoreState(pointerSnapshot);
+	
+	// Restore blocks content after the enemies creation marked their blocks
+	if (LevelManager::restoreState(pointerSnapshot) != 0) return -2;
+	
+	if (pointerSnapshot->isReadingFailed())
+	{
+		LOG_ERROR("World snapshot is truncated.");
+		return -2;
+	}
+	
+	HeadUpDisplay::setEnemiesAmount(_enemiesList.size());
+	
+	LOG_INFORMATION("World restored in %u us (level %d, %d enemies, simulation time %u ms, %d bytes).", (unsigned int) (((SDL_GetPerformanceCounter() - startingTime) * 1000000) / SDL_GetPerformanceFrequency()), loadedLevelNumber, (int) _enemiesList.size(), GameClock::getTime(), pointerSnapshot->getSize());
+	return 0;
+}
+
+/** Execute a single game logic tick. When a replay is played, the recorded inputs are used instead of the player ones and the resulting world state is checked against the recorded one. When a replay is recorded, the inputs and the resulting world state are appended to it.
+ * @return 0 if the tick was executed,
+ * @return 1 if the played replay has ended (the tick is not executed, the player gets the controls back),
+ * @return -1 if the world state diverged from the played replay one (the playback is stopped).
+ */
+static int _executeGameLogicTick()
+{
+	unsigned int keysState, worldHash, expectedWorldHash = 0;
+	
+	// Feed the game logic with the recorded inputs
+	if (ReplayManager::isPlaying())
+	{
+		if (ReplayManager::playTick(&keysState, &expectedWorldHash) != 0)
+		{
+			LOG_INFORMATION("Replay ended at simulation time %u ms.", GameClock::getTime());
+			ReplayManager::stopPlayback();
+			ControlManager::setGameplayKeysState(0); // Release all keys the replay was pressing
+			return 1;
+		}
+		ControlManager::setGameplayKeysState(keysState);
+	}
+	else
+	{
+		// Let the bot press the keys instead of the player
+		if (_isBotEnabled) ControlManager::setGameplayKeysState(BotManager::computeGameplayKeysState(&_enemiesList));
+		keysState = ControlManager::getGameplayKeysState();
+	}
+	
+	_saveMovingEntitiesPreviousPositions();
+	_handlePlayerControls();
+	_updateGameLogic();
+	GameClock::tick();
+	
+	// Hashing the world is only needed when a replay is recorded or played
+	if (ReplayManager::isRecording()) ReplayManager::recordTick(keysState, _computeWorldHash());
+	else if (ReplayManager::isPlaying())
+	{
+		worldHash = _computeWorldHash();
+		if (worldHash != expectedWorldHash)
+		{
+			LOG_ERROR("Replay diverged at simulation time %u ms (world hash is 0x%08X, recorded one is 0x%08X).", GameClock::getTime(), worldHash, expectedWorldHash);
+			ReplayManager::stopPlayback();
+			return -1;
+		}
+	}
+	
+	return 0;
+}
+
+/** Display and keep up to date interface strings. */
+static inline void _renderInterface()
+{
+	// Turn off all compass arrows, so only the appropriate ones will be lighted
+	for (int i = 0; i < HeadUpDisplay::COMPASS_ARROW_IDS_COUNT; i++) HeadUpDisplay::setCompassArrowState(static_cast<HeadUpDisplay::CompassArrowId>(i), false);
+	
+	// Detect enemy spawners positions against player to light the corresponding compass arrows
+	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+	EnemySpawnerStaticEntity *pointerSpawner;
+	int playerBlockX = pointerPlayer->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int playerBlockY = pointerPlayer->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int spawnerBlockX, spawnerBlockY;
+	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
+	{
+		// Compute spawner block position
+		pointerSpawner = *enemySpawnersListIterator;
+		spawnerBlockX = pointerSpawner->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		spawnerBlockY = pointerSpawner->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Is the spawner above the player ?
+		if (spawnerBlockY < playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_UP, true);
+		else if (spawnerBlockY > playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_DOWN, true);
+		
+		// Is the spawner on the player left ?
+		if (spawnerBlockX < playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_LEFT, true);
+		else if (spawnerBlockX > playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_RIGHT, true);
+	}
+	
+	HeadUpDisplay::render();
+	
+	// Display a centered message if needed
+	if (_isPlayerDead) Renderer::renderCenteredTexture(_pointerGameLostInterfaceStringTexture);
+	else if (_isGameFinished) Renderer::renderCenteredTexture(_pointerGameWonInterfaceStringTexture);
+}
+
+/** Display everything to the screen. */
+static inline void _renderGame()
+{
+	// Compute rendering top left coordinates (follow the player rendering position to avoid jerky scrolling)
+	int sceneX = pointerPlayer->getInterpolatedX() - _cameraOffsetX;
+	int sceneY = pointerPlayer->getInterpolatedY() - _cameraOffsetY;
+	Renderer::displayX = sceneX;
+	Renderer::displayY = sceneY;
+	
+	// Render the level walls and static objects (ammunition, medipacks, ...)
+	LevelManager::renderScene(sceneX, sceneY);
+	
+	// Display enemy spawners
+	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator) (*enemySpawnersListIterator)->render();
+	
+	// Display enemies
+	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator) (*enemiesListIterator)->render();
+	
+	// Display bullets after enemies, so when multiple enemies fire on themselves bullets are visible on top of enemies
+	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
+	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
+	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
+	
+	// Display the player now, so it is always rendered on top on everything else and can always be visible
+	pointerPlayer->render();
+	
+	// Display special effects at the end, so they can recover everything
+	EffectManager::render();
+	
+	// Display the red overlay
+	if (_isPlayerHit)
+	{
+		SDL_RenderCopy(Renderer::pointerRenderer, _pointerPlayerHitOverlayTexture->getSDLTexture(), NULL, NULL);
+		_isPlayerHit = false;
+	}
+	
+	// Display HUD
+	_renderInterface();
+}
+
+/** Start recording the game, using the current level and player statistics as starting conditions.
+ * @param pointerStringFileName The replay file to create.
+ * @param randomSeed The value the pseudo-random numbers streams are seeded with.
+ * @return 0 if the recording started,
+ * @return -1 if an error occurred.
+ */
+static int _startRecording(const char *pointerStringFileName, unsigned int randomSeed)
+{
+	ReplayManager::ReplayHeader replayHeader;
+	
+	replayHeader.randomSeed = randomSeed;
+	replayHeader.levelNumber = _currentLevelNumber;
+	replayHeader.playerMaximumLifePoints = pointerPlayer->getMaximumLifePointsAmount();
+	replayHeader.playerAmmunition = pointerPlayer->getAmmunitionAmount();
+	replayHeader.displayWidth = Renderer::displayWidth;
+	replayHeader.displayHeight = Renderer::displayHeight;
+	
+	if (ReplayManager::startRecording(pointerStringFileName, &replayHeader) != 0)
+	{
+		printf("Error : could not record replay file '%s', see log file for more details.\n", pointerStringFileName);
+		return -1;
+	}
+	return 0;
+}
+
+/** Load the current level again, giving back to the player the life points and ammunition it had when the level started. */
+static void _restartLevel()
+{
+	int levelToLoadNumber, lifePointsAmount;
+	
+	// The replay does not describe the game anymore
+	ReplayManager::stopRecording();
+	ReplayManager::stopPlayback();
+	
+	// Stop currently playing sounds
+	AudioManager::stopAllSounds();
+	
+	// Free all entities
+	_clearAllLists();
+	
+	// Choose level number to load (_loadNextLevel() automatically increments _currentLevelNumber)
+	if (_currentLevelNumber == 0) levelToLoadNumber = 0;
+	else levelToLoadNumber = _currentLevelNumber - 1;
+	
+	// Try to load the level
+	if (LevelManager::loadLevel(levelToLoadNumber) != 0)
+	{
+		LOG_ERROR("Failed to reload level %d.", levelToLoadNumber);
+		exit(-1);
+	}
+	
+	// Restore player life and ammunition count as they were at the level start
+	lifePointsAmount = SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS);
+	pointerPlayer->setLifePointsAmount(lifePointsAmount);
+	pointerPlayer->setMaximumLifePointsAmount(lifePointsAmount);
+	pointerPlayer->setAmmunitionAmount(SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION));
+	
+	// Allow the game to restart if the player is dead
+	if (_isPlayerDead)
+	{
+		_isPlayerDead = false;
+		_isGamePaused = false;
+	}
+}
+
+/** Execute game logic ticks in the calling thread world, the current level must have been loaded.
+ * @param ticksCount How many game logic updates to execute. The simulation stops before if the player dies, finishes the game or if the played replay ends or diverges.
+ * @param pointerResult On output, contain the simulation outcome.
+ */
+static void _simulateGame(int ticksCount, SimulationResult *pointerResult)
+{
+	int result = 0;
+	
+	pointerResult->executedTicksCount = 0;
+	while (pointerResult->executedTicksCount < ticksCount)
+	{
+		// The game is paused only when the player died or finished all levels
+		if (_isGamePaused) break;
+		
+		result = _executeGameLogicTick();
+		if (result == 1) break; // The played replay ended, so the tick was not executed
+		pointerResult->executedTicksCount++;
+		if (result == -1) break;
+	}
+	
+	pointerResult->levelNumber = _currentLevelNumber - 1;
+	pointerResult->playerLifePointsAmount = pointerPlayer->getLifePointsAmount();
+	pointerResult->isPlayerDead = _isPlayerDead;
+	pointerResult->isGameFinished = _isGameFinished;
+	pointerResult->isReplayDiverged = (result == -1);
+	pointerResult->worldHash = _computeWorldHash();
+}
+
+/** Run the game logic as fast as possible, without rendering nor waiting for the display. When a replay is played, this fast forwards through it and checks that the game logic still behaves the same.
+ * @param ticksCount How many game logic updates to execute. The simulation stops before if the player dies, finishes the game or if the played replay ends.
+ * @param pointerStringLoadedSnapshotFileName If not NULL, the simulation starts from the world stored in this snapshot file instead of the level beginning.
+ * @param pointerStringSavedSnapshotFileName If not NULL, the world is stored to this snapshot file when the simulation ends.
+ * @return 0 if the simulation succeeded,
+ * @return -1 if the played replay diverged from the recorded game or if a snapshot could not be loaded or saved.
+ */
+static int _runHeadlessSimulation(int ticksCount, const char *pointerStringLoadedSnapshotFileName, const char *pointerStringSavedSnapshotFileName)
+{
+	SimulationResult result;
+	Snapshot snapshot;
+	
+	GameClock::initialize();
+	if (pointerStringLoadedSnapshotFileName != NULL)
+	{
+		if ((snapshot.loadFromFile(pointerStringLoadedSnapshotFileName) != 0) || (_restoreWorld(&snapshot) != 0))
+		{
+			printf("Error : could not restore snapshot file '%s', see log file for more details.\n", pointerStringLoadedSnapshotFileName);
+			return -1;
+		}
+	}
+	// Load first level
+	else _loadNextLevel();
+	
+	unsigned int startingTime = SDL_GetTicks();
+	_simulateGame(ticksCount, &result);
+	unsigned int elapsedTime = SDL_GetTicks() - startingTime;
+	
+	// Display simulation statistics
+	printf("Simulated ticks : %d, elapsed time : %u ms", result.executedTicksCount, elapsedTime);
+	if (elapsedTime > 0) printf(", ticks per second : %u", (unsigned int) ((result.executedTicksCount * 1000ULL) / elapsedTime));
+	printf(".\nLevel : %d, enemies : %d, enemy spawners : %d, player life points : %d%s.\n", result.levelNumber, (int) _enemiesList.size(), (int) LevelManager::enemySpawnersList.size(), result.playerLifePointsAmount, result.isPlayerDead ? " (dead)" : (result.isGameFinished ? " (game finished)" : ""));
+	if (result.isReplayDiverged)
+	{
+		printf("Replay diverged from the recorded game after %d ticks.\n", result.executedTicksCount);
+		return -1;
+	}
+	printf("World hash : 0x%08X.\n", result.worldHash);
+	
+	if (pointerStringSavedSnapshotFileName != NULL)
+	{
+		_saveWorld(&snapshot);
+		if (snapshot.saveToFile(pointerStringSavedSnapshotFileName) != 0)
+		{
+			printf("Error : could not save snapshot file '%s', see log file for more details.\n", pointerStringSavedSnapshotFileName);
+			return -1;
+		}
+		printf("Saved world snapshot to '%s' (%d bytes).\n", pointerStringSavedSnapshotFileName, snapshot.getSize());
+	}
+	
+	return 0;
+}
+
+/** Simulate sessions until all of them have been taken by a thread. Each session is a whole game played in the calling thread world.
+ * @param pointerParameters The ParallelSimulationParameters shared by all threads.
+ * @return Always 0.
+ */
+static int _parallelSimulationThread(void *pointerParameters)
+{
+	ParallelSimulationParameters *pointerSimulationParameters = (ParallelSimulationParameters *) pointerParameters;
+	SimulationResult *pointerResult;
+	int sessionIndex;
+	
+	while (1)
+	{
+		// Take the next session to simulate
+		sessionIndex = SDL_AtomicAdd(&pointerSimulationParameters->nextSessionIndex, 1);
+		if (sessionIndex >= pointerSimulationParameters->sessionsCount) break;
+		
+		// Start a new game in this thread world
+		pointerPlayer = new PlayerFightingEntity(0, 0); // It will be placed at the right location by the level loading function
+		_currentLevelNumber = pointerSimulationParameters->startingLevelNumber;
+		_isPlayerDead = false;
+		_isGamePaused = false;
+		_isGameFinished = false;
+		_lastEnemySpawningTime = 0 - CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN;
+		RandomManager::initialize(pointerSimulationParameters->randomSeed + sessionIndex);
+		GameClock::initialize();
+		_loadNextLevel();
+		
+		pointerResult = &pointerSimulationParameters->pointerResults[sessionIndex];
+		_simulateGame(pointerSimulationParameters->ticksCount, pointerResult);
+		LOG_INFORMATION("Session %d : ticks : %d, level : %d, player life points : %d%s, world hash : 0x%08X.", sessionIndex, pointerResult->executedTicksCount, pointerResult->levelNumber, pointerResult->playerLifePointsAmount, pointerResult->isPlayerDead ? " (dead)" : (pointerResult->isGameFinished ? " (game finished)" : ""), pointerResult->worldHash);
+		
+		// Free the game
+		_clearAllLists();
+		delete pointerPlayer;
+		pointerPlayer = NULL;
+	}
+	
+	return 0;
+}
+
+/** Run many headless games at the same time, using one world per thread. Read-only game resources (textures, display size...) are shared by all threads.
+ * @param sessionsCount How many games to simulate.
+ * @param threadsCount How many threads to simulate the games with.
+ * @param ticksCount The maximum amount of game logic updates to execute for each game.
+ * @param startingLevelNumber The level all games start from.
+ * @param randomSeed Game n random numbers streams are seeded with this value plus n.
+ * @return 0 if all games were simulated,
+ * @return -1 if no simulation thread could be created.
+ */
+static int _runParallelHeadlessSimulations(int sessionsCount, int threadsCount, int ticksCount, int startingLevelNumber, unsigned int randomSeed)
+{
+	ParallelSimulationParameters simulationParameters;
+	SDL_Thread **pointerThreads;
+	int i, createdThreadsCount = 0, deadPlayersCount = 0, finishedGamesCount = 0;
+	unsigned long long totalTicksCount = 0, totalLevelsNumbers = 0;
+	
+	// Do not create useless threads
+	if (threadsCount > sessionsCount) threadsCount = sessionsCount;
+	
+	simulationParameters.sessionsCount = sessionsCount;
+	simulationParameters.ticksCount = ticksCount;
+	simulationParameters.startingLevelNumber = startingLevelNumber;
+	simulationParameters.randomSeed = randomSeed;
+	SDL_AtomicSet(&simulationParameters.nextSessionIndex, 0);
+	simulationParameters.pointerResults = new SimulationResult[sessionsCount];
+	
+	// Start all threads
+	unsigned int startingTime = SDL_GetTicks();
+	pointerThreads = new SDL_Thread *[threadsCount];
+	for (i = 0; i < threadsCount; i++)
+	{
+		pointerThreads[createdThreadsCount] = SDL_CreateThread(_parallelSimulationThread, "Simulation", &simulationParameters);
+		if (pointerThreads[createdThreadsCount] == NULL) LOG_ERROR("Failed to create simulation thread %d (%s).", i, SDL_GetError());
+		else createdThreadsCount++;
+	}
+	
+	// Wait for all sessions to be simulated
+	for (i = 0; i < createdThreadsCount; i++) SDL_WaitThread(pointerThreads[i], NULL);
+	unsigned int elapsedTime = SDL_GetTicks() - startingTime;
+	delete[] pointerThreads;
+	
+	if (createdThreadsCount == 0)
+	{
+		printf("Error : could not create any simulation thread, see log file for more details.\n");
+		delete[] simulationParameters.pointerResults;
+		return -1;
+	}
+	
+	// Gather all sessions results
+	for (i = 0; i < sessionsCount; i++)
+	{
+		totalTicksCount += simulationParameters.pointerResults[i].executedTicksCount;
+		totalLevelsNumbers += simulationParameters.pointerResults[i].levelNumber;
+		if (simulationParameters.pointerResults[i].isPlayerDead) deadPlayersCount++;
+		else if (simulationParameters.pointerResults[i].isGameFinished) finishedGamesCount++;
+	}
+	delete[] simulationParameters.pointerResults;
+	
+	// Display simulation statistics
+	printf("Simulated sessions : %d, threads : %d, simulated ticks : %llu, elapsed time : %u ms", sessionsCount, createdThreadsCount, totalTicksCount, elapsedTime);
+	if (elapsedTime > 0) printf(", ticks per second : %llu", (totalTicksCount * 1000ULL) / elapsedTime);
+	printf(".\nPlayer dead : %d, game finished : %d, still playing : %d, average level : %.2f.\n", deadPlayersCount, finishedGamesCount, sessionsCount - deadPlayersCount - finishedGamesCount, (double) totalLevelsNumbers / sessionsCount);
+	
+	return 0;
+}
+
+#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+/** Find a random block a benchmark scenario can add an entity to.
+ * @param pointerX On output, contain the block X coordinate in pixels.
+ * @param pointerY On output, contain the block Y coordinate in pixels.
+ * @return 0 if a free block was found,
+ * @return -1 if no free block was found (the level is almost full).
+ */
+static int _findBenchmarkFreeBlock(int *pointerX, int *pointerY)
+{
+	int i, x, y;
+	
+	// Do not put anything on the player
+	SDL_Rect *pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle();
+	int playerBlockX = (pointerPlayerPositionRectangle->x + (pointerPlayerPositionRectangle->w / 2)) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int playerBlockY = (pointerPlayerPositionRectangle->y + (pointerPlayerPositionRectangle->h / 2)) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+	
+	for (i = 0; i < 1000; i++)
+	{
+		x = RandomManager::generateNumber(RandomManager::STREAM_ID_BENCHMARK, LevelManager::getLevelWidthBlocks());
+		y = RandomManager::generateNumber(RandomManager::STREAM_ID_BENCHMARK, LevelManager::getLevelHeightBlocks());
+		if ((x == playerBlockX) && (y == playerBlockY)) continue;
+		
+		x *= CONFIGURATION_LEVEL_BLOCK_SIZE;
+		y *= CONFIGURATION_LEVEL_BLOCK_SIZE;
+		if (_isBlockAvailableForSpawn(x, y))
+		{
+			*pointerX = x;
+			*pointerY = y;
+			return 0;
+		}
+	}
+	
+	return -1;
+}
+
+/** Add an enemy to a random block, choosing its type according to the scenario enemies mix.
+ * @param pointerScenario The scenario being run.
+ * @return 0 if the enemy was added,
+ * @return -1 if there is no more room in the level.
+ */
+static int _spawnBenchmarkEnemy(Benchmark::Scenario *pointerScenario)
+{
+	int x, y, percentage;
+	EnemyFightingEntity *pointerEnemy;
+	SDL_Rect *pointerEnemyPositionRectangle;
+	
+	if (_findBenchmarkFreeBlock(&x, &y) != 0) return -1;
+	
+	percentage = RandomManager::generateNumber(RandomManager::STREAM_ID_BENCHMARK, 100);
+	if (percentage < pointerScenario->smallEnemiesPercentage) pointerEnemy = new SmallEnemyFightingEntity(x, y);
+	else if (percentage < pointerScenario->smallEnemiesPercentage + pointerScenario->mediumEnemiesPercentage) pointerEnemy = new MediumEnemyFightingEntity(x, y);
+	else pointerEnemy = new BigEnemyFightingEntity(x, y);
+	
+	// Put the enemy at the block center, like a spawner would do
+	pointerEnemyPositionRectangle = pointerEnemy->getPositionRectangle();
+	pointerEnemy->setX(x + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->w) / 2));
+	pointerEnemy->setY(y + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->h) / 2));
+	_addEnemy(pointerEnemy);
+	
+	return 0;
+}
+
+/** Fire a bullet from a random block in a random direction.
+ * @param isPlayerBullet Set to true to fire a player bullet, set to false to fire an enemy bullet.
+ */
+static void _spawnBenchmarkBullet(bool isPlayerBullet)
+{
+	int x, y;
+	MovingEntity::Direction direction;
+	
+	if (_findBenchmarkFreeBlock(&x, &y) != 0) return;
+	x += CONFIGURATION_LEVEL_BLOCK_SIZE / 2;
+	y += CONFIGURATION_LEVEL_BLOCK_SIZE / 2;
+	direction = (MovingEntity::Direction) RandomManager::generateNumber(RandomManager::STREAM_ID_BENCHMARK, MovingEntity::DIRECTIONS_COUNT);
+	
+	// Use the same bullets than the player primary fire and the small enemies
+	if (isPlayerBullet) _playerBulletsList.push_front(new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_PLAYER_BULLET_FACING_UP, 6, direction, 1, 1));
+	else _enemiesBulletsList.push_front(new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_SMALL_ENEMY_BULLET_FACING_UP, 6, direction, 1, 0));
+}
+
+/** Run benchmark scenarios one after the other, then store their measurements to a JSON file.
+ * @param pointerScenariosFileNames The scenario files.
+ * @param pointerStringResultsFileName The results file to create.
+ * @return 0 if all scenarios were run,
+ * @return -1 if a scenario could not be loaded or if the results could not be written.
+ */
+static int _runBenchmark(std::vector<const char *> *pointerScenariosFileNames, const char *pointerStringResultsFileName)
+{
+	Benchmark::Scenario scenario;
+	unsigned int i;
+	int j, spawnedEnemiesCount, bulletsCredit;
+	bool isPlayerBulletFired = true;
+	const char *pointerStringScenarioFileName;
+	
+	for (i = 0; i < pointerScenariosFileNames->size(); i++)
+	{
+		pointerStringScenarioFileName = (*pointerScenariosFileNames)[i];
+		if (Benchmark::loadScenario(pointerStringScenarioFileName, &scenario) != 0)
+		{
+			printf("Error : could not load benchmark scenario '%s', see log file for more details.\n", pointerStringScenarioFileName);
+			return -1;
+		}
+		printf("Running benchmark scenario '%s'...\n", pointerStringScenarioFileName);
+		
+		// Start from a new game
+		_clearAllLists();
+		delete pointerPlayer;
+		pointerPlayer = new PlayerFightingEntity(0, 0); // It will be placed at the right location by the level loading function
+		pointerPlayer->setMaximumLifePointsAmount(CONFIGURATION_BENCHMARK_PLAYER_LIFE_POINTS_AMOUNT);
+		_currentLevelNumber = scenario.levelNumber;
+		_isPlayerDead = false;
+		_isGamePaused = false;
+		_isGameFinished = false;
+		_lastEnemySpawningTime = 0 - CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN;
+		_isBotEnabled = scenario.isBotEnabled;
+		RandomManager::initialize(scenario.randomSeed);
+		GameClock::initialize();
+		_loadNextLevel();
+		
+		// Populate the level
+		for (spawnedEnemiesCount = 0; spawnedEnemiesCount < scenario.enemiesCount; spawnedEnemiesCount++)
+		{
+			if (_spawnBenchmarkEnemy(&scenario) != 0)
+			{
+				printf("Level %d is full, only %d enemies were spawned.\n", scenario.levelNumber, spawnedEnemiesCount);
+				break;
+			}
+		}
+		
+		Benchmark::beginScenario();
+		bulletsCredit = 0;
+		for (j = 0; j < scenario.ticksCount; j++)
+		{
+			// The game is paused only when the bot finished all levels
+			if (_isGamePaused) break;
+			
+			// Keep the player alive
+			pointerPlayer->setLifePointsAmount(pointerPlayer->getMaximumLifePointsAmount());
+			
+			// Fire the requested amount of bullets, alternating player and enemy bullets
+			bulletsCredit += scenario.bulletsPerSecond * CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS;
+			while (bulletsCredit >= 1000)
+			{
+				_spawnBenchmarkBullet(isPlayerBulletFired);
+				isPlayerBulletFired = !isPlayerBulletFired;
+				bulletsCredit -= 1000;
+			}
+			
+			Benchmark::beginTick();
+			_executeGameLogicTick();
+			Benchmark::endTick(_enemiesList.size(), LevelManager::enemySpawnersList.size(), _playerBulletsList.size(), _enemiesBulletsList.size());
+		}
+		Benchmark::endScenario(pointerStringScenarioFileName, &scenario);
+	}
+	
+	if (Benchmark::writeResults(pointerStringResultsFileName) != 0)
+	{
+		printf("Error : could not write benchmark results file '%s', see log file for more details.\n", pointerStringResultsFileName);
+		return -1;
+	}
+	printf("Benchmark results written to '%s'.\n", pointerStringResultsFileName);
+	return 0;
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	SDL_Event event;
+	unsigned int frameRateStartingTime = 0;
+	bool isFullScreenEnabled = true, isFramesPerSecondDisplayingEnabled = true;
+	isFullScreenEnabled = false;
+	int i, framesCount = 0, headlessTicksCount = 0, headlessSessionsCount = 1, headlessThreadsCount = 0, headlessStartingLevelNumber = 0;
+	int ticksCount;
+	float timeScale = 1;
+	const char *pointerStringRecordingFileName = NULL, *pointerStringPlaybackFileName = NULL, *pointerStringLoadedSnapshotFileName = NULL, *pointerStringSavedSnapshotFileName = NULL;
+	unsigned int randomSeed = time(NULL);
+	ReplayManager::ReplayHeader replayHeader;
+	#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+		std::vector<const char *> benchmarkScenariosFileNames;
+		const char *pointerStringBenchmarkResultsFileName = CONFIGURATION_BENCHMARK_DEFAULT_RESULTS_FILE_NAME;
+	#endif
 	SDL_Texture *pointerFramesPerSecondSdlTexture = NULL;
 	char stringFramesPerSecond[16];
 	static const char *pointerStringsMainMenuWithSavegameItems[] =
@@ -565,6 +1598,8 @@ int main(int argc, char *argv[])
 	static const char *pointerStringsPauseMenuItems[] =
 	{
 		"Continue",
+		"Save checkpoint",
+		"Load checkpoint",
 		"Restart level",
 		"Quit"
 	};
@@ -573,6 +1608,10 @@ int main(int argc, char *argv[])
 		"Relish your victory",
 		"Quit"
 	};
+	static const char *pointerStringsCheckpointErrorMenuItems[] =
+	{
+		"Continue"
+	};
 	
 	// Check parameters
 	if (argc > 1)
@@ -584,38 +1623,210 @@ int main(int argc, char *argv[])
 			if (strcmp("-fps", argv[i]) == 0) isFramesPerSecondDisplayingEnabled = true;
 			// Is full screen mode requested ?
 			else if (strcmp("-windowed", argv[i]) == 0) isFullScreenEnabled = false;
+			// Is a different game speed requested ?
+			else if ((strcmp("-time-scale", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				timeScale = atof(argv[i]);
+				if ((timeScale < CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE) || (timeScale > CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE))
+				{
+					printf("Error : the time scale must be in range [%g; %g].\n", CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE, CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE);
+					return -1;
+				}
+			}
+			// Is a simulation without display requested ?
+			else if (strcmp("-headless", argv[i]) == 0) _isHeadlessModeEnabled = true;
+			// Is the game played by the bot ?
+			else if (strcmp("-bot", argv[i]) == 0) _isBotEnabled = true;
+			#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+				// Add a benchmark scenario to run (scenarios are always run without display)
+				else if ((strcmp("-benchmark", argv[i]) == 0) && (i + 1 < argc))
+				{
+					i++;
+					benchmarkScenariosFileNames.push_back(argv[i]);
+					_isHeadlessModeEnabled = true;
+				}
+				// Where to write the benchmark results
+				else if ((strcmp("-results", argv[i]) == 0) && (i + 1 < argc))
+				{
+					i++;
+					pointerStringBenchmarkResultsFileName = argv[i];
+				}
+			#endif
+			// How many game logic updates to simulate in headless mode
+			else if ((strcmp("-ticks", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				headlessTicksCount = atoi(argv[i]);
+				if (headlessTicksCount <= 0)
+				{
+					printf("Error : the ticks count must be a positive number.\n");
+					return -1;
+				}
+			}
+			// How many games to simulate in headless mode
+			else if ((strcmp("-sessions", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				headlessSessionsCount = atoi(argv[i]);
+				if (headlessSessionsCount <= 0)
+				{
+					printf("Error : the sessions count must be a positive number.\n");
+					return -1;
+				}
+			}
+			// How many threads to simulate the games with
+			else if ((strcmp("-threads", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				headlessThreadsCount = atoi(argv[i]);
+				if (headlessThreadsCount <= 0)
+				{
+					printf("Error : the threads count must be a positive number.\n");
+					return -1;
+				}
+			}
+			// Which level the simulated games start from
+			else if ((strcmp("-level", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				headlessStartingLevelNumber = atoi(argv[i]);
+				if ((headlessStartingLevelNumber < 0) || (headlessStartingLevelNumber >= CONFIGURATION_LEVELS_COUNT))
+				{
+					printf("Error : the level number must be in range [0; %d].\n", CONFIGURATION_LEVELS_COUNT - 1);
+					return -1;
+				}
+			}
+			// Is a specific random seed requested ?
+			else if ((strcmp("-seed", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				randomSeed = strtoul(argv[i], NULL, 10);
+			}
+			// Is the game to be recorded ?
+			else if ((strcmp("-record", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				pointerStringRecordingFileName = argv[i];
+			}
+			// Is a recorded game to be replayed ?
+			else if ((strcmp("-replay", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				pointerStringPlaybackFileName = argv[i];
+			}
+			// Does the simulation start from a saved world ?
+			else if ((strcmp("-load-snapshot", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				pointerStringLoadedSnapshotFileName = argv[i];
+			}
+			// Is the world to be saved when the simulation ends ?
+			else if ((strcmp("-save-snapshot", argv[i]) == 0) && (i + 1 < argc))
+			{
+				i++;
+				pointerStringSavedSnapshotFileName = argv[i];
+			}
 			// Display help only if requested, because macOS may add custom parameters like -psn_0_340051
 			else if (strcmp("-help", argv[i]) == 0)
 			{
 				printf("Usage : %s [option].\n"
 					"Available options :\n"
-					"  -fps      : display frames per second count.\n"
-					"  -help     : display this help and exit.\n"
-					"  -windowed : play game in windowed screen mode.\n"
-					"All other parameters are ignored.\n", argv[0]);
+					#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+						"  -benchmark F     : run the benchmark scenario F without display, can be repeated to run several scenarios.\n"
+					#endif
+					"  -bot             : let a bot play the game instead of the player (the replays recorded meanwhile can be played without the bot).\n"
+					"  -fps             : display frames per second count.\n"
+					"  -headless        : simulate the game logic without display, audio nor controls, then exit.\n"
+					"  -help            : display this help and exit.\n"
+					"  -level N         : level the games start from in headless mode (default is 0).\n"
+					"  -load-snapshot F : start the headless simulation from the world saved in the file F.\n"
+					"  -record F        : record the game inputs to the file F.\n"
+					"  -replay F        : replay the game recorded in the file F (combine with -headless to quickly check the replay).\n"
+					#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+						"  -results F       : write the benchmark results to the JSON file F (default is " CONFIGURATION_BENCHMARK_DEFAULT_RESULTS_FILE_NAME ").\n"
+					#endif
+					"  -save-snapshot F : save the world to the file F when the headless simulation ends.\n"
+					"  -seed S          : seed the random numbers with S instead of the current time.\n"
+					"  -sessions N      : amount of games to simulate in headless mode, game n is seeded with S + n (default is 1).\n"
+					"  -threads N       : amount of threads simulating the games in headless mode (default is the processor cores count).\n"
+					"  -ticks N         : amount of game logic updates to simulate in headless mode (default is %d, or the whole replay with -replay).\n"
+					"  -time-scale S    : make the game run S times faster than real time (S must be in range [%g; %g]).\n"
+					"  -windowed        : play game in windowed screen mode.\n"
+					"All other parameters are ignored.\n", argv[0], CONFIGURATION_HEADLESS_DEFAULT_TICKS_COUNT, CONFIGURATION_GAME_CLOCK_MINIMUM_TIME_SCALE, CONFIGURATION_GAME_CLOCK_MAXIMUM_TIME_SCALE);
 				return 0;
 			}
 		}
 	}
+	if ((pointerStringRecordingFileName != NULL) && (pointerStringPlaybackFileName != NULL))
+	{
+		printf("Error : a game can't be recorded and replayed at the same time.\n");
+		return -1;
+	}
+	if ((headlessSessionsCount > 1) && ((pointerStringRecordingFileName != NULL) || (pointerStringPlaybackFileName != NULL)))
+	{
+		printf("Error : only a single session can be recorded or replayed.\n");
+		return -1;
+	}
+	if ((pointerStringLoadedSnapshotFileName != NULL) && ((headlessSessionsCount > 1) || (pointerStringRecordingFileName != NULL) || (pointerStringPlaybackFileName != NULL)))
+	{
+		printf("Error : a snapshot can only start a single session that is not recorded nor replayed.\n");
+		return -1;
+	}
 	
 	// Initialize logging system as soon as possible
 	if (FileManager::initialize() != 0) return -1; // Must be initialized before the subsystems that use it
 	if (Log::initialize() != 0) return -1;
 	
-	// Initialize the needed SDL subsystems
-	if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_AUDIO) != 0)
+	// Retrieve the game starting conditions from the replay file, they are needed by the subsystems initialization
+	if (pointerStringPlaybackFileName != NULL)
+	{
+		if (ReplayManager::startPlayback(pointerStringPlaybackFileName, &replayHeader) != 0)
+		{
+			printf("Error : could not play replay file '%s', see log file for more details.\n", pointerStringPlaybackFileName);
+			return -1;
+		}
+		randomSeed = replayHeader.randomSeed;
+	}
+	RandomManager::initialize(randomSeed); // Initialize pseudo-random numbers streams before any subsystem can use them
+	if (headlessTicksCount == 0)
+	{
+		if (pointerStringPlaybackFileName != NULL) headlessTicksCount = INT_MAX;
+		else headlessTicksCount = CONFIGURATION_HEADLESS_DEFAULT_TICKS_COUNT;
+	}
+	
+	// Initialize the needed SDL subsystems (only the timer is needed in headless mode)
+	if (_isHeadlessModeEnabled) i = SDL_Init(SDL_INIT_TIMER);
+	else i = SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_AUDIO);
+	if (i != 0)
 	{
 		LOG_ERROR("SDL_Init() failed (%s).", SDL_GetError());
 		return -1;
 	}
 	
-	// Engine initialization
-	if (Renderer::initialize(isFullScreenEnabled) != 0) return -1;
+	// Engine initialization (textures provide only their dimensions when no renderer is created)
+	if (!_isHeadlessModeEnabled)
+	{
+		if (Renderer::initialize(isFullScreenEnabled) != 0) return -1;
+	}
+	// Entities behavior depends on the display size, so simulate the recorded one
+	if (ReplayManager::isPlaying())
+	{
+		if (_isHeadlessModeEnabled)
+		{
+			Renderer::displayWidth = replayHeader.displayWidth;
+			Renderer::displayHeight = replayHeader.displayHeight;
+		}
+		else if ((Renderer::displayWidth != replayHeader.displayWidth) || (Renderer::displayHeight != replayHeader.displayHeight)) LOG_ERROR("The display size (%dx%d) differs from the recorded one (%dx%d), the replay will diverge.", Renderer::displayWidth, Renderer::displayHeight, replayHeader.displayWidth, replayHeader.displayHeight);
+	}
 	if (TextureManager::initialize() != 0) return -1;
 	if (LevelManager::initialize() != 0) return -1;
-	if (AudioManager::initialize() != 0) return -1;
-	if (ControlManager::initialize() != 0) return -1;
-	if (HeadUpDisplay::initialize() != 0) return -1;
+	if (!_isHeadlessModeEnabled)
+	{
+		if (AudioManager::initialize() != 0) return -1;
+		if (ControlManager::initialize() != 0) return -1;
+		if (HeadUpDisplay::initialize() != 0) return -1;
+	}
 	
 	// Create the player now that everything is working
 	pointerPlayer = new PlayerFightingEntity(0, 0); // It will be placed at the right location by the level loading function
@@ -623,8 +1834,34 @@ int main(int argc, char *argv[])
 	// Automatically dispose of allocated resources on program exit (allowing to use exit() elsewhere in the program)
 	atexit(_exitFreeResources);
 	
-	// Initialize pseudo-random numbers generator
-	srand(time(NULL));
+	// Start the game in the recorded conditions
+	if (_isHeadlessModeEnabled) _currentLevelNumber = headlessStartingLevelNumber;
+	if (ReplayManager::isPlaying())
+	{
+		_currentLevelNumber = replayHeader.levelNumber;
+		pointerPlayer->setLifePointsAmount(replayHeader.playerMaximumLifePoints);
+		pointerPlayer->setMaximumLifePointsAmount(replayHeader.playerMaximumLifePoints);
+		pointerPlayer->setAmmunitionAmount(replayHeader.playerAmmunition);
+	}
+	
+	// Simulate the game logic then exit
+	if (_isHeadlessModeEnabled)
+	{
+		LOG_INFORMATION("Game engine successfully initialized in headless mode.");
+		#ifdef CONFIGURATION_BUILD_FOR_BENCHMARK
+			if (!benchmarkScenariosFileNames.empty()) return _runBenchmark(&benchmarkScenariosFileNames, pointerStringBenchmarkResultsFileName);
+		#endif
+		if (headlessSessionsCount > 1)
+		{
+			if (headlessThreadsCount == 0) headlessThreadsCount = SDL_GetCPUCount();
+			return _runParallelHeadlessSimulations(headlessSessionsCount, headlessThreadsCount, headlessTicksCount, headlessStartingLevelNumber, randomSeed);
+		}
+		if (pointerStringRecordingFileName != NULL)
+		{
+			if (_startRecording(pointerStringRecordingFileName, randomSeed) != 0) return -1;
+		}
+		return _runHeadlessSimulation(headlessTicksCount, pointerStringLoadedSnapshotFileName, pointerStringSavedSnapshotFileName);
+	}
 	
 	// Cache some values
 	// Offset to subtract to the player position to have the scene camera coordinates
@@ -638,10 +1875,10 @@ int main(int argc, char *argv[])
 	
 	LOG_INFORMATION("Game engine successfully initialized.");
 	
-	// Display the main menu and get user choice
-	bool isMainMenuDisplayed = true;
+	// Display the main menu and get user choice (a replay starts immediately)
+	bool isMainMenuDisplayed = !ReplayManager::isPlaying();
 	bool isSavegamePresent = SavegameManager::isSavegamePresent(); // Cache value to avoid checking for the file every time the menu is displayed
-	do
+	while (isMainMenuDisplayed)
 	{
 		if (isSavegamePresent)
 		{
@@ -666,17 +1903,17 @@ int main(int argc, char *argv[])
 					else LOG_ERROR("No valid savegame found, starting a new game.");
 					isMainMenuDisplayed = false;
 					break;
-					
+				
 				// Start a new game (nothing to do because all needed variables are already initialized)
 				case 1:
 					isMainMenuDisplayed = false;
 					break;
-					
+				
 				// Display controls menu
 				case 2:
 					if (Menu::displayControlsMenu() != 0) goto Exit;
 					break;
-					
+				
 				default:
 					goto Exit;
 			}
@@ -689,17 +1926,23 @@ int main(int argc, char *argv[])
 				case 0:
 					isMainMenuDisplayed = false;
 					break;
-					
+				
 				// Display controls menu
 				case 1:
 					if (Menu::displayControlsMenu() != 0) goto Exit;
 					break;
-					
+				
 				default:
 					goto Exit;
 			}
 		}
-	} while (isMainMenuDisplayed);
+	}
+	
+	// The game starting conditions are known now
+	if (pointerStringRecordingFileName != NULL)
+	{
+		if (_startRecording(pointerStringRecordingFileName, randomSeed) != 0) return -1;
+	}
 	
 	// Load first level
 	_loadNextLevel();
@@ -708,6 +1951,8 @@ int main(int argc, char *argv[])
 	// Create a fake texture to be used by the FPS displaying code, this avoids multiple checks to detect whether the first texture is null
 	if (isFramesPerSecondDisplayingEnabled) pointerFramesPerSecondSdlTexture = Renderer::renderTextToTexture("--", Renderer::TEXT_COLOR_ID_RED, Renderer::FONT_SIZE_ID_BIG); // Provided text can't have a zero character size or it would trigger a SDL error
 	
+	GameClock::initialize();
+	GameClock::setTimeScale(timeScale);
 	while (1)
 	{
 		Renderer::beginFrame();
@@ -725,13 +1970,13 @@ int main(int argc, char *argv[])
 			{
 				case SDL_QUIT:
 					goto Exit;
-					
+				
 				case SDL_CONTROLLERBUTTONUP:
 				case SDL_CONTROLLERBUTTONDOWN:
 				case SDL_CONTROLLERAXISMOTION:
 					ControlManager::handleGameControllerEvent(&event);
 					break;
-					
+				
 				case SDL_KEYUP:
 				case SDL_KEYDOWN:
 					ControlManager::handleKeyboardEvent(&event);
@@ -745,6 +1990,7 @@ int main(int argc, char *argv[])
 			// Stop playing music while the game is paused (in case the game must be quickly hidden to an incoming person)
 			LOG_DEBUG("Game paused.");
 			AudioManager::pauseMusic(1);
+			GameClock::setPaused(true);
 			
 			// Player won, display a specific menu
 			if (_isGameFinished)
@@ -754,45 +2000,49 @@ int main(int argc, char *argv[])
 			// Normal pause menu
 			else
 			{
-				switch (Menu::display("Pause", pointerStringsPauseMenuItems, 3))
+				switch (Menu::display("Pause", pointerStringsPauseMenuItems, 5))
 				{
 					// Player has selected "Continue"
 					case 0:
 						break;
 					
-					// Player has selected "Restart level"
+					// Player has selected "Save checkpoint"
 					case 1:
-						// Stop currently playing sounds
-						AudioManager::stopAllSounds();
-						
-						// Free all entities
-						_clearAllLists();
-						
-						// Choose level number to load (_loadNextLevel() automatically increments _currentLevelNumber)
-						if (_currentLevelNumber == 0) levelToLoadNumber = 0;
-						else levelToLoadNumber = _currentLevelNumber - 1;
-						
-						// Try to load the level
-						if (LevelManager::loadLevel(levelToLoadNumber) != 0)
-						{
-							LOG_ERROR("Failed to reload level %d.", levelToLoadNumber);
-							exit(-1);
-						}
-						
-						// Restore player life and ammunition count as they were at the level start
-						i = SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS); // Recycle 'i' variable
-						pointerPlayer->setLifePointsAmount(i);
-						pointerPlayer->setMaximumLifePointsAmount(i);
-						pointerPlayer->setAmmunitionAmount(SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION));
+						// Keep the checkpoint in memory to restore it instantly, and in a file to restore it when the game is launched again
+						_saveWorld(&_checkpointSnapshot);
+						_checkpointSnapshot.saveToFile(FileManager::getFilePath(CONFIGURATION_CHECKPOINT_FILE_NAME));
+						LOG_DEBUG("Saved checkpoint (%d bytes).", _checkpointSnapshot.getSize());
+						break;
+					
+					// Player has selected "Load checkpoint"
+					case 2:
+						// Retrieve the checkpoint saved when the game was previously launched
+						if (_checkpointSnapshot.isEmpty() && (_checkpointSnapshot.loadFromFile(FileManager::getFilePath(CONFIGURATION_CHECKPOINT_FILE_NAME)) != 0)) break;
 						
-						// Allow the game to restart if the player is dead
-						if (_isPlayerDead)
+						switch (_restoreWorld(&_checkpointSnapshot))
 						{
-							_isPlayerDead = false;
-							_isGamePaused = false;
+							// The checkpoint was rejected before the world was modified, so the game can continue
+							case -1:
+								LOG_ERROR("Failed to load checkpoint, it is not compatible with this game version.");
+								if (Menu::display("Checkpoint can't be loaded", pointerStringsCheckpointErrorMenuItems, 1) < 0) goto Exit;
+								break;
+							
+							// The world may have been partially overwritten, start the level again from a known state
+							case -2:
+								LOG_ERROR("Failed to load checkpoint, restarting level.");
+								_restartLevel();
+								break;
+							
+							default:
+								break;
 						}
 						break;
 					
+					// Player has selected "Restart level"
+					case 3:
+						_restartLevel();
+						break;
+					
 					default:
 						goto Exit;
 				}
@@ -800,54 +2050,23 @@ int main(int argc, char *argv[])
 			
 			LOG_DEBUG("Game continuing.");
 			AudioManager::pauseMusic(0);
+			GameClock::setPaused(false);
 		}
 		
-		// Do not update the game anymore if the player died
-		if (!_isGamePaused)
+		// Execute as many fixed period game logic ticks as needed to catch up with the elapsed time, so the game speed does not depend on the display refresh rate
+		ticksCount = GameClock::computeTicksToExecuteCount();
+		for (i = 0; i < ticksCount; i++)
 		{
-			// React to player key press without depending of keyboard key repetition rate
-			// Handle both vertical and horizontal direction movement
-			if ((ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) && (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)))
-			{
-				// Keep trace of the last direction the player took to favor it, when this key will be released the previous direction will be favored
-				if (ControlManager::isLastPressedDirectionKeyOnVerticalAxis())
-				{
-					if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
-					else pointerPlayer->moveToDown();
-				}
-				else
-				{
-					if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
-					else pointerPlayer->moveToRight();
-				}
-			}
-			// Handle a single key press
-			else
-			{
-				if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) pointerPlayer->moveToDown();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)) pointerPlayer->moveToRight();
-			}
+			// Do not update the game anymore if the player died
+			if (_isGamePaused) break;
 			
-			// Fire a bullet
-			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_PRIMARY_SHOOT))
-			{
-				// Is the player allowed to shoot ?
-				pointerBullet = pointerPlayer->shoot();
-				if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
-			}
-			// Fire a mortar shell (bullet and mortar shell can be shot in the same time)
-			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_SECONDARY_SHOOT))
-			{
-				// Is the player allowed to shoot ?
-				pointerBullet = pointerPlayer->shootSecondaryFire();
-				if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
-			}
-			
-			_updateGameLogic();
+			// Give the controls back to the player if the replay diverged
+			if (_executeGameLogicTick() == -1) ControlManager::setGameplayKeysState(0);
 		}
 		
+		// Render moving entities between the two last ticks according to the time remaining before the next tick
+		Renderer::ticksInterpolationFactor = GameClock::getTicksInterpolationFactor();
+		
 		_renderGame();
 		
 		// Append the FPS string before displaying the rendered frame
@@ -872,9 +2091,11 @@ int main(int argc, char *argv[])
 		}
 		
 		Renderer::endFrame();
-		emscripten_sleep(0);
+		#ifdef __EMSCRIPTEN__
+			emscripten_sleep(0);
+		#endif
 	}
-	
+
 Exit:
 	return EXIT_SUCCESS;
 }
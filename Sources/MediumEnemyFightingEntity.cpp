@@ -10,6 +10,11 @@ MediumEnemyFightingEntity::MediumEnemyFightingEntity(int x, int y): EnemyFightin
 
 MediumEnemyFightingEntity::~MediumEnemyFightingEntity() {}
 
+EnemyFightingEntity::EnemyType MediumEnemyFightingEntity::getType()
+{
+	return ENEMY_TYPE_MEDIUM;
+}
+
 int MediumEnemyFightingEntity::update()
 {
 	// Update textures to show enemy damage state
@@ -31,6 +36,19 @@ int MediumEnemyFightingEntity::update()
 	return EnemyFightingEntity::update();
 }
 
+void MediumEnemyFightingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	TextureManager::TextureId facingUpTextureId;
+	
+	EnemyFightingEntity::restoreState(pointerSnapshot);
+	
+	// Show the damage state update() displayed when the enemy reached this life points amount
+	if (_lifePointsAmount <= 1) facingUpTextureId = TextureManager::TEXTURE_ID_MEDIUM_ENEMY_DAMAGED_2_FACING_UP;
+	else if (_lifePointsAmount <= 2) facingUpTextureId = TextureManager::TEXTURE_ID_MEDIUM_ENEMY_DAMAGED_1_FACING_UP;
+	else facingUpTextureId = TextureManager::TEXTURE_ID_MEDIUM_ENEMY_FACING_UP;
+	for (int i = 0; i < DIRECTIONS_COUNT; i++) _pointerTextures[i] = TextureManager::getTextureFromId((TextureManager::TextureId) (facingUpTextureId + i)); // Facing down, left and right textures follow the facing up one
+}
+
 BulletMovingEntity *MediumEnemyFightingEntity::_fireBullet(int x, int y)
 {
 	return new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_MEDIUM_ENEMY_BULLET_FACING_UP, 5, _facingDirection, 3, 0);
@@ -11,7 +11,9 @@
 #include <Renderer.hpp>
 #include <SDL2/SDL.h>
 #include <TextureManager.hpp>
-#include <emscripten.h>
+#ifdef __EMSCRIPTEN__
+	#include <emscripten.h>
+#endif
 
 namespace Menu
 {
@@ -190,7 +192,9 @@ namespace Menu
 			}
 			
 			Renderer::endFrame();
-			emscripten_sleep(0);
+			#ifdef __EMSCRIPTEN__
+				emscripten_sleep(0);
+			#endif
 		}
 		
 	Exit:
@@ -268,7 +272,9 @@ namespace Menu
 			Renderer::renderTexture(_menuItems[_menuItemsCount - 1].pointerFocusedTexture, _menuItems[_menuItemsCount - 1].x, _menuItems[_menuItemsCount - 1].y);
 			
 			Renderer::endFrame();
-			emscripten_sleep(0);
+			#ifdef __EMSCRIPTEN__
+				emscripten_sleep(0);
+			#endif
 		}
 		
 		Exit:
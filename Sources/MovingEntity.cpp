@@ -26,6 +26,10 @@ MovingEntity::MovingEntity(int x, int y, TextureManager::TextureId facingUpTextu
 	
 	_movingPixelsAmount = movingPixelsAmount;
 	
+	// Do not interpolate from somewhere else on spawn
+	_previousX = x;
+	_previousY = y;
+	
 	// Collide with walls by default
 	_collisionBlockContent = LevelManager::BLOCK_CONTENT_WALL;
 	
@@ -47,6 +51,9 @@ void MovingEntity::setX(int x)
 	_positionRectangles[DIRECTION_DOWN].x = x;
 	_positionRectangles[DIRECTION_LEFT].x = x;
 	_positionRectangles[DIRECTION_RIGHT].x = x;
+	
+	// The entity is teleported, so there is nothing to interpolate
+	_previousX = x;
 }
 
 int MovingEntity::getY()
@@ -61,6 +68,9 @@ void MovingEntity::setY(int y)
 	_positionRectangles[DIRECTION_DOWN].y = y;
 	_positionRectangles[DIRECTION_LEFT].y = y;
 	_positionRectangles[DIRECTION_RIGHT].y = y;
+	
+	// The entity is teleported, so there is nothing to interpolate
+	_previousY = y;
 }
 
 SDL_Rect *MovingEntity::getPositionRectangle()
@@ -225,11 +235,26 @@ void MovingEntity::turnToRight()
 	_facingDirection = DIRECTION_RIGHT;
 }
 
+void MovingEntity::savePreviousPosition()
+{
+	_previousX = _positionRectangles[_facingDirection].x;
+	_previousY = _positionRectangles[_facingDirection].y;
+}
+
+int MovingEntity::getInterpolatedX()
+{
+	return _previousX + (int) ((_positionRectangles[_facingDirection].x - _previousX) * Renderer::ticksInterpolationFactor);
+}
+
+int MovingEntity::getInterpolatedY()
+{
+	return _previousY + (int) ((_positionRectangles[_facingDirection].y - _previousY) * Renderer::ticksInterpolationFactor);
+}
+
 void MovingEntity::render()
 {
-	// Display the texture
-	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
-	_pointerTextures[_facingDirection]->render(pointerPositionRectangle->x - Renderer::displayX, pointerPositionRectangle->y - Renderer::displayY);
+	// Display the texture at the position interpolated between the two last game ticks
+	_pointerTextures[_facingDirection]->render(getInterpolatedX() - Renderer::displayX, getInterpolatedY() - Renderer::displayY);
 	
 	// Display collision rectangle in debug mode
 	#if CONFIGURATION_LOG_LEVEL == 3
@@ -251,3 +276,33 @@ void MovingEntity::render()
 	}
 	#endif
 }
+
+void MovingEntity::saveState(Snapshot *pointerSnapshot)
+{
+	pointerSnapshot->writeInteger(_facingDirection);
+	pointerSnapshot->writeInteger(_movingPixelsAmount);
+	pointerSnapshot->writeInteger(_collisionBlockContent);
+	pointerSnapshot->writeInteger(_positionRectangles[DIRECTION_UP].x); // All rectangles share the same coordinates
+	pointerSnapshot->writeInteger(_positionRectangles[DIRECTION_UP].y);
+	pointerSnapshot->writeInteger(_previousX);
+	pointerSnapshot->writeInteger(_previousY);
+}
+
+void MovingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	int facingDirection = pointerSnapshot->readInteger();
+	if ((facingDirection < 0) || (facingDirection >= DIRECTIONS_COUNT)) facingDirection = DIRECTION_UP; // Do not access the arrays out of bounds if the snapshot is corrupted
+	_facingDirection = (Direction) facingDirection;
+	_movingPixelsAmount = pointerSnapshot->readInteger();
+	_collisionBlockContent = pointerSnapshot->readInteger();
+	
+	// Use the setters to allow child classes to move their own rectangles too
+	int x = pointerSnapshot->readInteger();
+	int y = pointerSnapshot->readInteger();
+	setX(x);
+	setY(y);
+	
+	// Setters cancelled interpolation, so restore it now
+	_previousX = pointerSnapshot->readInteger();
+	_previousY = pointerSnapshot->readInteger();
+}
@@ -0,0 +1,965 @@
+/** @file PathfindingManager.cpp
+ * See PathfindingManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <algorithm>
+#include <cassert>
+#include <Configuration.hpp>
+#include <cstdlib>
+#include <LevelManager.hpp>
+#include <PathfindingManager.hpp>
+#include <PlayerFightingEntity.hpp>
+#include <utility>
+#include <vector>
+
+namespace PathfindingManager
+{
+	/** The flow field value of the blocks the player can't be reached from (obstacles and blocks further than CONFIGURATION_PATHFINDING_FLOW_FIELD_MAXIMUM_DISTANCE included). */
+	#define FLOW_FIELD_UNREACHABLE_DISTANCE 0xFFFF
+
+	/** How many blocks must be crossed to reach the player block from each level block, stored a level row after another. */
+	static thread_local std::vector<unsigned short> &_flowFieldDistances = *new std::vector<unsigned short>(); // Never destroyed, like the other world lists
+	/** The blocks having a distance in the flow field, so only them need to be cleared when the flow field is computed again. */
+	static thread_local std::vector<int> &_reachedBlocksIndexes = *new std::vector<int>();
+	/** The blocks whose distance changed and whose neighbors must be looked at. */
+	static thread_local std::vector<int> &_blocksQueue = *new std::vector<int>();
+	/** The blocks that became obstacles or stopped being obstacles since the last flow field update. */
+	static thread_local std::vector<int> &_changedObstaclesBlocksIndexes = *new std::vector<int>();
+
+	/** The block the flow field leads to, or -1 if the flow field must be computed again. */
+	static thread_local int _flowFieldTargetBlockIndex = -1;
+	/** The level width in blocks when the flow field was computed. */
+	static thread_local int _levelWidthBlocks;
+	/** The level height in blocks when the flow field was computed. */
+	static thread_local int _levelHeightBlocks;
+
+	/** The clusters graph cost of the nodes that can't be reached. */
+	#define CLUSTERS_GRAPH_UNREACHABLE_COST 0x7FFFFFFF
+	/** Cluster border crossings at least this long get a node at each end instead of a single node in the middle, so paths do not need to make a detour through the middle of a wide opening. */
+	#define CLUSTERS_GRAPH_WIDE_CROSSING_LENGTH 6
+
+	/** A clusters graph edge. */
+	typedef struct
+	{
+		int nodeIndex; //!< The node the edge leads to.
+		int cost; //!< How many blocks must be crossed to reach the node.
+	} ClustersGraphEdge;
+
+	/** A remembered path first step. */
+	typedef struct
+	{
+		int startingBlockIndex; //!< The block the path starts from, or -1 if the cache entry is empty.
+		int goalBlockIndex; //!< The block the path leads to.
+		int direction; //!< The direction to go to from the starting block, or -1 if the goal can't be reached.
+		int cost; //!< The path length in blocks, or CLUSTERS_GRAPH_UNREACHABLE_COST if the goal can't be reached.
+	} CachedPath;
+
+	/** How many clusters the level is split in horizontally. */
+	static thread_local int _clustersCountX;
+	/** How many clusters the level is split in vertically. */
+	static thread_local int _clustersCountY;
+	/** How many nodes the clusters graph contains. */
+	static thread_local int _nodesCount;
+	/** The block each clusters graph node stands on (or -1 for the nodes removed when the graph was repaired, which stay unused until the graph is built again). Nodes are placed on both sides of the places where a path can cross a cluster border. */
+	static thread_local std::vector<int> &_nodesBlocksIndexes = *new std::vector<int>();
+	/** The edges leaving each node, they lead to the other nodes of the same cluster and to the node on the other side of the cluster border. The vectors of the unused nodes are kept to avoid allocating memory again when the graph is built again. */
+	static thread_local std::vector<std::vector<ClustersGraphEdge> > &_nodesEdges = *new std::vector<std::vector<ClustersGraphEdge> >();
+	/** The nodes of each cluster, a cluster row after another. */
+	static thread_local std::vector<std::vector<int> > &_clustersNodesIndexes = *new std::vector<std::vector<int> >();
+	/** The node standing on each level block (or -1), stored a level row after another. */
+	static thread_local std::vector<int> &_blocksNodesIndexes = *new std::vector<int>();
+
+	/** The distances computed by _computeClusterDistances(), stored a cluster row after another. */
+	static thread_local int _clusterDistances[CONFIGURATION_PATHFINDING_CLUSTER_SIZE * CONFIGURATION_PATHFINDING_CLUSTER_SIZE];
+	/** The X coordinate (in blocks) of the cluster _clusterDistances belongs to. */
+	static thread_local int _clusterDistancesX;
+	/** The Y coordinate (in blocks) of the cluster _clusterDistances belongs to. */
+	static thread_local int _clusterDistancesY;
+	/** The blocks that are waiting to be visited when the distances inside a cluster are computed. */
+	static thread_local std::vector<int> &_clusterBlocksQueue = *new std::vector<int>();
+
+	/** The cost of the best known path from the starting block to each node, the starting and goal blocks are the two last nodes. */
+	static thread_local std::vector<int> &_nodesCosts = *new std::vector<int>();
+	/** The node each node is reached from on the best known path. */
+	static thread_local std::vector<int> &_nodesParentsIndexes = *new std::vector<int>();
+	/** The cost to reach the goal block from the nodes of its cluster. */
+	static thread_local std::vector<int> &_nodesGoalCosts = *new std::vector<int>();
+	/** The nodes waiting to be expanded as (estimated path cost, node) pairs, stored as a heap keeping the node to expand first on top. */
+	static thread_local std::vector<std::pair<int, int> > &_openNodes = *new std::vector<std::pair<int, int> >();
+
+	/** The last paths first steps, so enemies staying on the same block do not search their path again. */
+	static thread_local CachedPath _pathsCache[CONFIGURATION_PATHFINDING_PATHS_CACHE_SIZE];
+
+	/** The connected region each level block belongs to (or -1 for the obstacles), stored a level row after another. A block can be reached from another one only if both are in the same region. */
+	static thread_local std::vector<int> &_blocksRegionsIds = *new std::vector<int>();
+	/** How many blocks each region contains, indexed by region identifier. Merged regions keep an empty entry. */
+	static thread_local std::vector<int> &_regionsBlocksCounts = *new std::vector<int>();
+	/** Incremented each time the regions are labeled or merged, so blocks that could not reach each other may be able to now. */
+	static thread_local unsigned int _regionsVersion = 0;
+
+	/** Give a block a shorter distance to the player, then queue it so its neighbors get shorter distances too.
+	 * @param xBlock The block X coordinate (in blocks).
+	 * @param yBlock The block Y coordinate (in blocks).
+	 * @param distance The block new distance.
+	 */
+	static inline void _decreaseBlockDistance(int xBlock, int yBlock, int distance)
+	{
+		// Obstacles and level borders are never entered
+		if (LevelManager::isObstacleBlock(xBlock, yBlock)) return;
+		
+		int blockIndex = (yBlock * _levelWidthBlocks) + xBlock;
+		if (_flowFieldDistances[blockIndex] <= distance) return;
+		
+		if (_flowFieldDistances[blockIndex] == FLOW_FIELD_UNREACHABLE_DISTANCE) _reachedBlocksIndexes.push_back(blockIndex);
+		_flowFieldDistances[blockIndex] = distance;
+		_blocksQueue.push_back(blockIndex);
+	}
+
+	/** Spread the distance decreases of the queued blocks as a wavefront, which stops at the blocks that already have a shorter distance and at the flow field maximum distance. */
+	static void _propagateDistances()
+	{
+		int blockIndex, xBlock, yBlock, neighborDistance;
+		unsigned int queueIndex;
+		
+		// The queue is never emptied while it is processed, so it keeps the blocks in visiting order
+		for (queueIndex = 0; queueIndex < _blocksQueue.size(); queueIndex++)
+		{
+			blockIndex = _blocksQueue[queueIndex];
+			neighborDistance = _flowFieldDistances[blockIndex] + 1;
+			if (neighborDistance > CONFIGURATION_PATHFINDING_FLOW_FIELD_MAXIMUM_DISTANCE) continue;
+			
+			xBlock = blockIndex % _levelWidthBlocks;
+			yBlock = blockIndex / _levelWidthBlocks;
+			_decreaseBlockDistance(xBlock, yBlock - 1, neighborDistance);
+			_decreaseBlockDistance(xBlock, yBlock + 1, neighborDistance);
+			_decreaseBlockDistance(xBlock - 1, yBlock, neighborDistance);
+			_decreaseBlockDistance(xBlock + 1, yBlock, neighborDistance);
+		}
+		_blocksQueue.clear();
+	}
+
+	/** Compute the whole flow field toward a block with a breadth-first search bounded by the flow field maximum distance.
+	 * @param xTargetBlock The target block X coordinate (in blocks).
+	 * @param yTargetBlock The target block Y coordinate (in blocks).
+	 */
+	static void _computeFlowField(int xTargetBlock, int yTargetBlock)
+	{
+		unsigned int i;
+		
+		// Forget the previous flow field, only the blocks it reached need to be cleared
+		for (i = 0; i < _reachedBlocksIndexes.size(); i++) _flowFieldDistances[_reachedBlocksIndexes[i]] = FLOW_FIELD_UNREACHABLE_DISTANCE;
+		_reachedBlocksIndexes.clear();
+		
+		_flowFieldTargetBlockIndex = (yTargetBlock * _levelWidthBlocks) + xTargetBlock;
+		_decreaseBlockDistance(xTargetBlock, yTargetBlock, 0);
+		_propagateDistances();
+	}
+
+	/** Update the flow field after an obstacle has been removed from a block. Paths can only become shorter, so only the blocks getting closer to the player are visited.
+	 * @param blockIndex The freed block.
+	 */
+	static void _repairFreedBlock(int blockIndex)
+	{
+		int xBlock = blockIndex % _levelWidthBlocks;
+		int yBlock = blockIndex / _levelWidthBlocks;
+		int distance = FLOW_FIELD_UNREACHABLE_DISTANCE;
+		
+		// The freed block is reached through its closest neighbor
+		if ((yBlock > 0) && (_flowFieldDistances[blockIndex - _levelWidthBlocks] < distance)) distance = _flowFieldDistances[blockIndex - _levelWidthBlocks];
+		if ((yBlock < _levelHeightBlocks - 1) && (_flowFieldDistances[blockIndex + _levelWidthBlocks] < distance)) distance = _flowFieldDistances[blockIndex + _levelWidthBlocks];
+		if ((xBlock > 0) && (_flowFieldDistances[blockIndex - 1] < distance)) distance = _flowFieldDistances[blockIndex - 1];
+		if ((xBlock < _levelWidthBlocks - 1) && (_flowFieldDistances[blockIndex + 1] < distance)) distance = _flowFieldDistances[blockIndex + 1];
+		if (distance >= CONFIGURATION_PATHFINDING_FLOW_FIELD_MAXIMUM_DISTANCE) return; // The block is out of the flow field
+		
+		_decreaseBlockDistance(xBlock, yBlock, distance + 1);
+		_propagateDistances();
+	}
+
+	/** Compute the distances from a block to all blocks of its cluster, without leaving the cluster. Read them with _getClusterDistance().
+	 * @param blockIndex The block to start from.
+	 */
+	static void _computeClusterDistances(int blockIndex)
+	{
+		int xBlock, yBlock, clusterWidth, clusterHeight, distance, i;
+		unsigned int queueIndex;
+		
+		xBlock = blockIndex % _levelWidthBlocks;
+		yBlock = blockIndex / _levelWidthBlocks;
+		_clusterDistancesX = (xBlock / CONFIGURATION_PATHFINDING_CLUSTER_SIZE) * CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		_clusterDistancesY = (yBlock / CONFIGURATION_PATHFINDING_CLUSTER_SIZE) * CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		for (i = 0; i < CONFIGURATION_PATHFINDING_CLUSTER_SIZE * CONFIGURATION_PATHFINDING_CLUSTER_SIZE; i++) _clusterDistances[i] = CLUSTERS_GRAPH_UNREACHABLE_COST;
+		
+		// The clusters on the level right and bottom borders can be smaller
+		clusterWidth = std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelWidthBlocks - _clusterDistancesX);
+		clusterHeight = std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelHeightBlocks - _clusterDistancesY);
+		
+		// Breadth-first search using cluster coordinates
+		_clusterBlocksQueue.clear();
+		_clusterBlocksQueue.push_back(((yBlock - _clusterDistancesY) * CONFIGURATION_PATHFINDING_CLUSTER_SIZE) + (xBlock - _clusterDistancesX));
+		_clusterDistances[_clusterBlocksQueue[0]] = 0;
+		for (queueIndex = 0; queueIndex < _clusterBlocksQueue.size(); queueIndex++)
+		{
+			i = _clusterBlocksQueue[queueIndex];
+			xBlock = i % CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+			yBlock = i / CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+			distance = _clusterDistances[i] + 1;
+			
+			if ((yBlock > 0) && (_clusterDistances[i - CONFIGURATION_PATHFINDING_CLUSTER_SIZE] == CLUSTERS_GRAPH_UNREACHABLE_COST) && !LevelManager::isObstacleBlock(_clusterDistancesX + xBlock, _clusterDistancesY + yBlock - 1))
+			{
+				_clusterDistances[i - CONFIGURATION_PATHFINDING_CLUSTER_SIZE] = distance;
+				_clusterBlocksQueue.push_back(i - CONFIGURATION_PATHFINDING_CLUSTER_SIZE);
+			}
+			if ((yBlock < clusterHeight - 1) && (_clusterDistances[i + CONFIGURATION_PATHFINDING_CLUSTER_SIZE] == CLUSTERS_GRAPH_UNREACHABLE_COST) && !LevelManager::isObstacleBlock(_clusterDistancesX + xBlock, _clusterDistancesY + yBlock + 1))
+			{
+				_clusterDistances[i + CONFIGURATION_PATHFINDING_CLUSTER_SIZE] = distance;
+				_clusterBlocksQueue.push_back(i + CONFIGURATION_PATHFINDING_CLUSTER_SIZE);
+			}
+			if ((xBlock > 0) && (_clusterDistances[i - 1] == CLUSTERS_GRAPH_UNREACHABLE_COST) && !LevelManager::isObstacleBlock(_clusterDistancesX + xBlock - 1, _clusterDistancesY + yBlock))
+			{
+				_clusterDistances[i - 1] = distance;
+				_clusterBlocksQueue.push_back(i - 1);
+			}
+			if ((xBlock < clusterWidth - 1) && (_clusterDistances[i + 1] == CLUSTERS_GRAPH_UNREACHABLE_COST) && !LevelManager::isObstacleBlock(_clusterDistancesX + xBlock + 1, _clusterDistancesY + yBlock))
+			{
+				_clusterDistances[i + 1] = distance;
+				_clusterBlocksQueue.push_back(i + 1);
+			}
+		}
+	}
+
+	/** Get a distance computed by the last _computeClusterDistances() call.
+	 * @param blockIndex The block to get the distance of.
+	 * @return CLUSTERS_GRAPH_UNREACHABLE_COST if the block is not in the same cluster or can't be reached without leaving the cluster,
+	 * @return the distance in blocks.
+	 */
+	static inline int _getClusterDistance(int blockIndex)
+	{
+		int xBlock = (blockIndex % _levelWidthBlocks) - _clusterDistancesX;
+		int yBlock = (blockIndex / _levelWidthBlocks) - _clusterDistancesY;
+		
+		if ((xBlock < 0) || (xBlock >= CONFIGURATION_PATHFINDING_CLUSTER_SIZE) || (yBlock < 0) || (yBlock >= CONFIGURATION_PATHFINDING_CLUSTER_SIZE)) return CLUSTERS_GRAPH_UNREACHABLE_COST;
+		return _clusterDistances[(yBlock * CONFIGURATION_PATHFINDING_CLUSTER_SIZE) + xBlock];
+	}
+
+	/** Tell which cluster a block belongs to.
+	 * @param blockIndex The block.
+	 * @return The cluster index, clusters are stored a row after another.
+	 */
+	static inline int _getBlockClusterIndex(int blockIndex)
+	{
+		return (((blockIndex / _levelWidthBlocks) / CONFIGURATION_PATHFINDING_CLUSTER_SIZE) * _clustersCountX) + ((blockIndex % _levelWidthBlocks) / CONFIGURATION_PATHFINDING_CLUSTER_SIZE);
+	}
+
+	/** Get the clusters graph node standing on a block, creating it if needed.
+	 * @param blockIndex The block.
+	 * @return The node index.
+	 */
+	static int _addNode(int blockIndex)
+	{
+		if (_blocksNodesIndexes[blockIndex] != -1) return _blocksNodesIndexes[blockIndex];
+		
+		// Reuse the edges vectors of the previous graph
+		if (_nodesCount < (int) _nodesEdges.size()) _nodesEdges[_nodesCount].clear();
+		else _nodesEdges.push_back(std::vector<ClustersGraphEdge>());
+		_nodesBlocksIndexes.push_back(blockIndex);
+		_clustersNodesIndexes[_getBlockClusterIndex(blockIndex)].push_back(_nodesCount);
+		_blocksNodesIndexes[blockIndex] = _nodesCount;
+		
+		_nodesCount++;
+		return _nodesCount - 1;
+	}
+
+	/** Connect two nodes of the clusters graph in both ways.
+	 * @param firstNodeIndex The first node.
+	 * @param secondNodeIndex The second node.
+	 * @param cost How many blocks separate the nodes.
+	 */
+	static inline void _addEdge(int firstNodeIndex, int secondNodeIndex, int cost)
+	{
+		ClustersGraphEdge edge;
+		
+		edge.cost = cost;
+		edge.nodeIndex = secondNodeIndex;
+		_nodesEdges[firstNodeIndex].push_back(edge);
+		edge.nodeIndex = firstNodeIndex;
+		_nodesEdges[secondNodeIndex].push_back(edge);
+	}
+
+	/** Find where a path can cross a part of a cluster border, then add a pair of nodes for each crossing.
+	 * @param xBlock The X coordinate (in blocks) of the border part first block, located on the left or top cluster side.
+	 * @param yBlock The Y coordinate (in blocks) of the border part first block.
+	 * @param length The border part length in blocks.
+	 * @param isBorderVertical Set to true if the border separates a cluster from the cluster on its right, set to false if it separates a cluster from the cluster below.
+	 */
+	static void _addBorderNodes(int xBlock, int yBlock, int length, bool isBorderVertical)
+	{
+		int alongX = isBorderVertical ? 0 : 1, alongY = isBorderVertical ? 1 : 0, acrossX = alongY, acrossY = alongX;
+		int i, crossingStart = -1, crossingLength, crossingPositions[2], crossingPositionsCount, j, blockIndex;
+		bool isCrossable;
+		
+		// Look for runs of blocks that are free on both sides of the border (the loop goes one block further to close the last run)
+		for (i = 0; i <= length; i++)
+		{
+			isCrossable = (i < length) && !LevelManager::isObstacleBlock(xBlock + (i * alongX), yBlock + (i * alongY)) && !LevelManager::isObstacleBlock(xBlock + (i * alongX) + acrossX, yBlock + (i * alongY) + acrossY);
+			if (isCrossable)
+			{
+				if (crossingStart == -1) crossingStart = i;
+				continue;
+			}
+			if (crossingStart == -1) continue;
+			
+			crossingLength = i - crossingStart;
+			if (crossingLength < CLUSTERS_GRAPH_WIDE_CROSSING_LENGTH)
+			{
+				crossingPositions[0] = crossingStart + (crossingLength / 2);
+				crossingPositionsCount = 1;
+			}
+			else
+			{
+				crossingPositions[0] = crossingStart;
+				crossingPositions[1] = i - 1;
+				crossingPositionsCount = 2;
+			}
+			for (j = 0; j < crossingPositionsCount; j++)
+			{
+				blockIndex = ((yBlock + (crossingPositions[j] * alongY)) * _levelWidthBlocks) + xBlock + (crossingPositions[j] * alongX);
+				_addEdge(_addNode(blockIndex), _addNode(blockIndex + (acrossY * _levelWidthBlocks) + acrossX), 1);
+			}
+			crossingStart = -1;
+		}
+	}
+
+	/** Remove the edges leading from a node to another one.
+	 * @param nodeIndex The node the edges leave.
+	 * @param removedNodeIndex The node the removed edges lead to.
+	 */
+	static void _removeEdges(int nodeIndex, int removedNodeIndex)
+	{
+		std::vector<ClustersGraphEdge> *pointerEdges = &_nodesEdges[nodeIndex];
+		unsigned int i = 0;
+		
+		while (i < pointerEdges->size())
+		{
+			if ((*pointerEdges)[i].nodeIndex == removedNodeIndex) pointerEdges->erase(pointerEdges->begin() + i);
+			else i++;
+		}
+	}
+
+	/** Remove the crossings of a part of a cluster border added by _addBorderNodes(), then remove the nodes that do not lead to another cluster anymore. The edges connecting the nodes inside their cluster must be computed again.
+	 * @param xBlock The X coordinate (in blocks) of the border part first block, located on the left or top cluster side.
+	 * @param yBlock The Y coordinate (in blocks) of the border part first block.
+	 * @param length The border part length in blocks.
+	 * @param isBorderVertical Set to true if the border separates a cluster from the cluster on its right, set to false if it separates a cluster from the cluster below.
+	 */
+	static void _removeBorderNodes(int xBlock, int yBlock, int length, bool isBorderVertical)
+	{
+		int alongX = isBorderVertical ? 0 : 1, alongY = isBorderVertical ? 1 : 0, acrossX = alongY, acrossY = alongX;
+		int i, j, side, blockIndex, nodeIndex, acrossNodeIndex, clusterIndex, edgeBlockIndex;
+		unsigned int k;
+		std::vector<int> *pointerClusterNodesIndexes;
+		bool isCrossingBorder;
+		
+		// Forget the crossings, each one connects the nodes standing on both sides of the border
+		for (i = 0; i < length; i++)
+		{
+			blockIndex = ((yBlock + (i * alongY)) * _levelWidthBlocks) + xBlock + (i * alongX);
+			nodeIndex = _blocksNodesIndexes[blockIndex];
+			acrossNodeIndex = _blocksNodesIndexes[blockIndex + (acrossY * _levelWidthBlocks) + acrossX];
+			if ((nodeIndex == -1) || (acrossNodeIndex == -1)) continue;
+			_removeEdges(nodeIndex, acrossNodeIndex);
+			_removeEdges(acrossNodeIndex, nodeIndex);
+		}
+		
+		// Remove the nodes left without crossing, a node on a cluster corner can still cross the other border
+		for (side = 0; side < 2; side++)
+		{
+			for (i = 0; i < length; i++)
+			{
+				blockIndex = ((yBlock + (i * alongY) + (side * acrossY)) * _levelWidthBlocks) + xBlock + (i * alongX) + (side * acrossX);
+				nodeIndex = _blocksNodesIndexes[blockIndex];
+				if (nodeIndex == -1) continue;
+				
+				clusterIndex = _getBlockClusterIndex(blockIndex);
+				isCrossingBorder = false;
+				for (k = 0; k < _nodesEdges[nodeIndex].size(); k++)
+				{
+					edgeBlockIndex = _nodesBlocksIndexes[_nodesEdges[nodeIndex][k].nodeIndex];
+					if ((edgeBlockIndex != -1) && (_getBlockClusterIndex(edgeBlockIndex) != clusterIndex))
+					{
+						isCrossingBorder = true;
+						break;
+					}
+				}
+				if (isCrossingBorder) continue;
+				
+				// The edges leading to the node from its cluster are removed when the cluster nodes are connected again
+				pointerClusterNodesIndexes = &_clustersNodesIndexes[clusterIndex];
+				for (j = 0; j < (int) pointerClusterNodesIndexes->size(); j++)
+				{
+					if ((*pointerClusterNodesIndexes)[j] == nodeIndex)
+					{
+						pointerClusterNodesIndexes->erase(pointerClusterNodesIndexes->begin() + j);
+						break;
+					}
+				}
+				_nodesEdges[nodeIndex].clear();
+				_nodesBlocksIndexes[nodeIndex] = -1;
+				_blocksNodesIndexes[blockIndex] = -1;
+			}
+		}
+	}
+
+	/** Connect the nodes of a cluster that can reach each other without leaving the cluster (each pair is connected once), replacing the previous connections.
+	 * @param clusterIndex The cluster.
+	 */
+	static void _connectClusterNodes(int clusterIndex)
+	{
+		std::vector<int> *pointerClusterNodesIndexes = &_clustersNodesIndexes[clusterIndex];
+		std::vector<ClustersGraphEdge> *pointerEdges;
+		int clusterNodesCount = (int) pointerClusterNodesIndexes->size(), i, j, distance, edgeNodeIndex;
+		unsigned int k;
+		
+		// Keep only the edges crossing the cluster border
+		for (i = 0; i < clusterNodesCount; i++)
+		{
+			pointerEdges = &_nodesEdges[(*pointerClusterNodesIndexes)[i]];
+			k = 0;
+			while (k < pointerEdges->size())
+			{
+				edgeNodeIndex = (*pointerEdges)[k].nodeIndex;
+				if ((_nodesBlocksIndexes[edgeNodeIndex] == -1) || (_getBlockClusterIndex(_nodesBlocksIndexes[edgeNodeIndex]) == clusterIndex)) pointerEdges->erase(pointerEdges->begin() + k);
+				else k++;
+			}
+		}
+		
+		for (i = 0; i < clusterNodesCount - 1; i++)
+		{
+			_computeClusterDistances(_nodesBlocksIndexes[(*pointerClusterNodesIndexes)[i]]);
+			for (j = i + 1; j < clusterNodesCount; j++)
+			{
+				distance = _getClusterDistance(_nodesBlocksIndexes[(*pointerClusterNodesIndexes)[j]]);
+				if (distance != CLUSTERS_GRAPH_UNREACHABLE_COST) _addEdge((*pointerClusterNodesIndexes)[i], (*pointerClusterNodesIndexes)[j], distance);
+			}
+		}
+	}
+
+	/** Split the level in clusters, find where paths can cross the clusters borders, then connect the crossings of each cluster with the path lengths inside the cluster. */
+	static void _buildClustersGraph()
+	{
+		int i, x, y, clustersCount;
+		
+		_clustersCountX = (_levelWidthBlocks + CONFIGURATION_PATHFINDING_CLUSTER_SIZE - 1) / CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		_clustersCountY = (_levelHeightBlocks + CONFIGURATION_PATHFINDING_CLUSTER_SIZE - 1) / CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		clustersCount = _clustersCountX * _clustersCountY;
+		
+		// Forget the previous graph, keeping its memory
+		_nodesCount = 0;
+		_nodesBlocksIndexes.clear();
+		if ((int) _clustersNodesIndexes.size() < clustersCount) _clustersNodesIndexes.resize(clustersCount);
+		for (i = 0; i < clustersCount; i++) _clustersNodesIndexes[i].clear();
+		_blocksNodesIndexes.assign(_levelWidthBlocks * _levelHeightBlocks, -1);
+		
+		// Add the nodes on both sides of the vertical borders, then on both sides of the horizontal ones
+		for (x = CONFIGURATION_PATHFINDING_CLUSTER_SIZE; x < _levelWidthBlocks; x += CONFIGURATION_PATHFINDING_CLUSTER_SIZE)
+		{
+			for (y = 0; y < _levelHeightBlocks; y += CONFIGURATION_PATHFINDING_CLUSTER_SIZE) _addBorderNodes(x - 1, y, std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelHeightBlocks - y), true);
+		}
+		for (y = CONFIGURATION_PATHFINDING_CLUSTER_SIZE; y < _levelHeightBlocks; y += CONFIGURATION_PATHFINDING_CLUSTER_SIZE)
+		{
+			for (x = 0; x < _levelWidthBlocks; x += CONFIGURATION_PATHFINDING_CLUSTER_SIZE) _addBorderNodes(x, y - 1, std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelWidthBlocks - x), false);
+		}
+		
+		// Connect the nodes of each cluster that can reach each other without leaving the cluster
+		for (i = 0; i < clustersCount; i++) _connectClusterNodes(i);
+		
+		// Remembered paths may not exist anymore
+		for (i = 0; i < CONFIGURATION_PATHFINDING_PATHS_CACHE_SIZE; i++) _pathsCache[i].startingBlockIndex = -1;
+	}
+
+	/** Forget the remembered paths that could go through a level area. A path can't go through the area if the area is further than the path length from the path ends.
+	 * @param leftBlockX The area left column (in blocks).
+	 * @param topBlockY The area top row (in blocks).
+	 * @param rightBlockX The area right column (in blocks).
+	 * @param bottomBlockY The area bottom row (in blocks).
+	 */
+	static void _forgetPathsCrossingArea(int leftBlockX, int topBlockY, int rightBlockX, int bottomBlockY)
+	{
+		int i, j, blockIndex, xBlock, yBlock, distance;
+		
+		for (i = 0; i < CONFIGURATION_PATHFINDING_PATHS_CACHE_SIZE; i++)
+		{
+			if (_pathsCache[i].startingBlockIndex == -1) continue;
+			
+			// Sum the Manhattan distances from both path ends to the area
+			distance = 0;
+			for (j = 0; j < 2; j++)
+			{
+				blockIndex = (j == 0) ? _pathsCache[i].startingBlockIndex : _pathsCache[i].goalBlockIndex;
+				xBlock = blockIndex % _levelWidthBlocks;
+				yBlock = blockIndex / _levelWidthBlocks;
+				if (xBlock < leftBlockX) distance += leftBlockX - xBlock;
+				else if (xBlock > rightBlockX) distance += xBlock - rightBlockX;
+				if (yBlock < topBlockY) distance += topBlockY - yBlock;
+				else if (yBlock > bottomBlockY) distance += yBlock - bottomBlockY;
+			}
+			
+			// A path as long as the remembered one going through the area could be preferred to it too
+			if (distance <= _pathsCache[i].cost) _pathsCache[i].startingBlockIndex = -1;
+		}
+	}
+
+	/** Update the clusters graph after an obstacle has been removed from a block. Only the block cluster distances and the crossings of the cluster borders the block stands on can change, so only these crossings and the nodes of the clusters they connect are updated.
+	 * @param blockIndex The freed block.
+	 */
+	static void _repairClustersGraph(int blockIndex)
+	{
+		int xBlock = blockIndex % _levelWidthBlocks, yBlock = blockIndex / _levelWidthBlocks, clusterX, clusterY, clusterWidth, clusterHeight, clusterIndex;
+		int bordersCount = 0, bordersXBlocks[4], bordersYBlocks[4], bordersLengths[4], connectedClustersIndexes[5], i;
+		int leftBlockX, topBlockY, rightBlockX, bottomBlockY;
+		bool areBordersVertical[4];
+		
+		// The clusters on the level right and bottom borders can be smaller
+		clusterX = (xBlock / CONFIGURATION_PATHFINDING_CLUSTER_SIZE) * CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		clusterY = (yBlock / CONFIGURATION_PATHFINDING_CLUSTER_SIZE) * CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		clusterWidth = std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelWidthBlocks - clusterX);
+		clusterHeight = std::min(CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelHeightBlocks - clusterY);
+		clusterIndex = _getBlockClusterIndex(blockIndex);
+		connectedClustersIndexes[0] = clusterIndex;
+		leftBlockX = clusterX;
+		topBlockY = clusterY;
+		rightBlockX = clusterX + clusterWidth - 1;
+		bottomBlockY = clusterY + clusterHeight - 1;
+		
+		// Find the cluster borders the block stands on, vertical borders first like when the whole graph is built
+		if ((xBlock == clusterX) && (clusterX > 0))
+		{
+			bordersXBlocks[bordersCount] = clusterX - 1;
+			bordersYBlocks[bordersCount] = clusterY;
+			bordersLengths[bordersCount] = clusterHeight;
+			areBordersVertical[bordersCount] = true;
+			bordersCount++;
+			connectedClustersIndexes[bordersCount] = clusterIndex - 1;
+			leftBlockX -= CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		}
+		if ((xBlock == clusterX + clusterWidth - 1) && (clusterX + clusterWidth < _levelWidthBlocks))
+		{
+			bordersXBlocks[bordersCount] = xBlock;
+			bordersYBlocks[bordersCount] = clusterY;
+			bordersLengths[bordersCount] = clusterHeight;
+			areBordersVertical[bordersCount] = true;
+			bordersCount++;
+			connectedClustersIndexes[bordersCount] = clusterIndex + 1;
+			rightBlockX = std::min(rightBlockX + CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelWidthBlocks - 1);
+		}
+		if ((yBlock == clusterY) && (clusterY > 0))
+		{
+			bordersXBlocks[bordersCount] = clusterX;
+			bordersYBlocks[bordersCount] = clusterY - 1;
+			bordersLengths[bordersCount] = clusterWidth;
+			areBordersVertical[bordersCount] = false;
+			bordersCount++;
+			connectedClustersIndexes[bordersCount] = clusterIndex - _clustersCountX;
+			topBlockY -= CONFIGURATION_PATHFINDING_CLUSTER_SIZE;
+		}
+		if ((yBlock == clusterY + clusterHeight - 1) && (clusterY + clusterHeight < _levelHeightBlocks))
+		{
+			bordersXBlocks[bordersCount] = clusterX;
+			bordersYBlocks[bordersCount] = yBlock;
+			bordersLengths[bordersCount] = clusterWidth;
+			areBordersVertical[bordersCount] = false;
+			bordersCount++;
+			connectedClustersIndexes[bordersCount] = clusterIndex + _clustersCountX;
+			bottomBlockY = std::min(bottomBlockY + CONFIGURATION_PATHFINDING_CLUSTER_SIZE, _levelHeightBlocks - 1);
+		}
+		
+		// Find the crossings of these borders again
+		for (i = 0; i < bordersCount; i++) _removeBorderNodes(bordersXBlocks[i], bordersYBlocks[i], bordersLengths[i], areBordersVertical[i]);
+		for (i = 0; i < bordersCount; i++) _addBorderNodes(bordersXBlocks[i], bordersYBlocks[i], bordersLengths[i], areBordersVertical[i]);
+		
+		// The distances inside the block cluster changed, and the clusters on the other side of the borders may have gained or lost nodes
+		for (i = 0; i <= bordersCount; i++) _connectClusterNodes(connectedClustersIndexes[i]);
+		
+		// Only the remembered paths that could go through the updated clusters may have changed
+		_forgetPathsCrossingArea(leftBlockX, topBlockY, rightBlockX, bottomBlockY);
+	}
+
+	/** Estimate the cost of a path between two blocks, without overestimating it.
+	 * @param firstBlockIndex The first block.
+	 * @param secondBlockIndex The second block.
+	 * @return The Manhattan distance between the blocks.
+	 */
+	static inline int _estimatePathCost(int firstBlockIndex, int secondBlockIndex)
+	{
+		return abs((firstBlockIndex % _levelWidthBlocks) - (secondBlockIndex % _levelWidthBlocks)) + abs((firstBlockIndex / _levelWidthBlocks) - (secondBlockIndex / _levelWidthBlocks));
+	}
+
+	/** Tell if a queued node must be expanded after another one. Nodes having the same estimated path cost are expanded in their blocks order, so the found path does not depend on the order the nodes were added to the graph (which changes when the graph is repaired instead of being built again).
+	 * @param firstOpenNode The first node, as an (estimated path cost, node) pair.
+	 * @param secondOpenNode The second node, as an (estimated path cost, node) pair.
+	 * @return true if the first node must be expanded after the second one,
+	 * @return false otherwise.
+	 */
+	static bool _isOpenNodeExpandedAfter(const std::pair<int, int> &firstOpenNode, const std::pair<int, int> &secondOpenNode)
+	{
+		int firstBlockIndex, secondBlockIndex;
+		
+		if (firstOpenNode.first != secondOpenNode.first) return firstOpenNode.first > secondOpenNode.first;
+		
+		// The starting and goal nodes are not in the graph, the order they are expanded in does not change the found path
+		firstBlockIndex = (firstOpenNode.second < _nodesCount) ? _nodesBlocksIndexes[firstOpenNode.second] : -1;
+		secondBlockIndex = (secondOpenNode.second < _nodesCount) ? _nodesBlocksIndexes[secondOpenNode.second] : -1;
+		return firstBlockIndex > secondBlockIndex;
+	}
+
+	/** Remember a shorter path to a node and queue the node to be expanded.
+	 * @param nodeIndex The node.
+	 * @param parentNodeIndex The node the path comes from.
+	 * @param cost The path cost.
+	 * @param goalBlockIndex The goal block, to estimate the remaining path cost.
+	 */
+	static inline void _reachNode(int nodeIndex, int parentNodeIndex, int cost, int goalBlockIndex)
+	{
+		int estimatedCost = cost;
+		
+		if (cost >= _nodesCosts[nodeIndex]) return;
+		_nodesCosts[nodeIndex] = cost;
+		_nodesParentsIndexes[nodeIndex] = parentNodeIndex;
+		
+		// The goal node is the last one and has no block of its own in the graph
+		if (nodeIndex < _nodesCount) estimatedCost += _estimatePathCost(_nodesBlocksIndexes[nodeIndex], goalBlockIndex);
+		_openNodes.push_back(std::make_pair(estimatedCost, nodeIndex));
+		std::push_heap(_openNodes.begin(), _openNodes.end(), _isOpenNodeExpandedAfter);
+	}
+
+	/** Get the blocks located above, below, on the left and on the right of a block.
+	 * @param blockIndex The block.
+	 * @param pointerNeighborsIndexes On output, contain the 4 neighbor blocks, or -1 for the neighbors outside of the level.
+	 */
+	static inline void _getNeighborsIndexes(int blockIndex, int *pointerNeighborsIndexes)
+	{
+		int xBlock = blockIndex % _levelWidthBlocks, yBlock = blockIndex / _levelWidthBlocks;
+		
+		pointerNeighborsIndexes[0] = (yBlock > 0) ? blockIndex - _levelWidthBlocks : -1;
+		pointerNeighborsIndexes[1] = (yBlock < _levelHeightBlocks - 1) ? blockIndex + _levelWidthBlocks : -1;
+		pointerNeighborsIndexes[2] = (xBlock > 0) ? blockIndex - 1 : -1;
+		pointerNeighborsIndexes[3] = (xBlock < _levelWidthBlocks - 1) ? blockIndex + 1 : -1;
+	}
+
+	/** Give the same identifier to all level blocks that can reach each other. */
+	static void _labelRegions()
+	{
+		int blockIndex, regionId = 0, neighborsIndexes[4], i;
+		unsigned int queueIndex;
+		
+		_blocksRegionsIds.assign(_levelWidthBlocks * _levelHeightBlocks, -1);
+		_regionsBlocksCounts.clear();
+		for (blockIndex = 0; blockIndex < _levelWidthBlocks * _levelHeightBlocks; blockIndex++)
+		{
+			if ((_blocksRegionsIds[blockIndex] != -1) || LevelManager::isObstacleBlock(blockIndex % _levelWidthBlocks, blockIndex / _levelWidthBlocks)) continue;
+			
+			// Flood the region from its first free block
+			_blocksRegionsIds[blockIndex] = regionId;
+			_blocksQueue.push_back(blockIndex);
+			for (queueIndex = 0; queueIndex < _blocksQueue.size(); queueIndex++)
+			{
+				_getNeighborsIndexes(_blocksQueue[queueIndex], neighborsIndexes);
+				for (i = 0; i < 4; i++)
+				{
+					if ((neighborsIndexes[i] == -1) || (_blocksRegionsIds[neighborsIndexes[i]] != -1) || LevelManager::isObstacleBlock(neighborsIndexes[i] % _levelWidthBlocks, neighborsIndexes[i] / _levelWidthBlocks)) continue;
+					_blocksRegionsIds[neighborsIndexes[i]] = regionId;
+					_blocksQueue.push_back(neighborsIndexes[i]);
+				}
+			}
+			_regionsBlocksCounts.push_back(_blocksQueue.size());
+			_blocksQueue.clear();
+			regionId++;
+		}
+		
+		_regionsVersion++;
+	}
+
+	/** Update the regions after an obstacle has been removed from a block. Freeing a block can only join the regions around it, so only the smaller joined regions are labeled again, and the regions version changes only if some regions were joined.
+	 * @param blockIndex The freed block.
+	 */
+	static void _mergeFreedBlockRegions(int blockIndex)
+	{
+		int neighborsIndexes[4], floodedNeighborsIndexes[4], regionId = -1, mergedRegionId, i, j;
+		unsigned int queueIndex;
+		
+		_getNeighborsIndexes(blockIndex, neighborsIndexes);
+		
+		// Keep the identifier of the biggest neighbor region, so the fewest blocks are labeled again
+		for (i = 0; i < 4; i++)
+		{
+			if ((neighborsIndexes[i] == -1) || (_blocksRegionsIds[neighborsIndexes[i]] == -1)) continue;
+			if ((regionId == -1) || (_regionsBlocksCounts[_blocksRegionsIds[neighborsIndexes[i]]] > _regionsBlocksCounts[regionId])) regionId = _blocksRegionsIds[neighborsIndexes[i]];
+		}
+		
+		// A block surrounded by obstacles is a new region, nothing can reach it
+		if (regionId == -1)
+		{
+			regionId = _regionsBlocksCounts.size();
+			_regionsBlocksCounts.push_back(0);
+		}
+		_blocksRegionsIds[blockIndex] = regionId;
+		_regionsBlocksCounts[regionId]++;
+		
+		// Give the kept identifier to the other neighbor regions
+		for (i = 0; i < 4; i++)
+		{
+			if (neighborsIndexes[i] == -1) continue;
+			mergedRegionId = _blocksRegionsIds[neighborsIndexes[i]];
+			if ((mergedRegionId == -1) || (mergedRegionId == regionId)) continue;
+			
+			_blocksRegionsIds[neighborsIndexes[i]] = regionId;
+			_blocksQueue.push_back(neighborsIndexes[i]);
+			for (queueIndex = 0; queueIndex < _blocksQueue.size(); queueIndex++)
+			{
+				_getNeighborsIndexes(_blocksQueue[queueIndex], floodedNeighborsIndexes);
+				for (j = 0; j < 4; j++)
+				{
+					if ((floodedNeighborsIndexes[j] == -1) || (_blocksRegionsIds[floodedNeighborsIndexes[j]] != mergedRegionId)) continue;
+					_blocksRegionsIds[floodedNeighborsIndexes[j]] = regionId;
+					_blocksQueue.push_back(floodedNeighborsIndexes[j]);
+				}
+			}
+			_regionsBlocksCounts[regionId] += _regionsBlocksCounts[mergedRegionId];
+			_regionsBlocksCounts[mergedRegionId] = 0;
+			_blocksQueue.clear();
+			
+			_regionsVersion++;
+		}
+	}
+
+	/** Tell which region a level location belongs to.
+	 * @param x The location X coordinate in pixels.
+	 * @param y The location Y coordinate in pixels.
+	 * @return -1 if the location is outside of the level or on an obstacle,
+	 * @return the region identifier.
+	 */
+	static inline int _getRegionId(int x, int y)
+	{
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		if ((x < 0) || (xBlock >= _levelWidthBlocks) || (y < 0) || (yBlock >= _levelHeightBlocks)) return -1;
+		return _blocksRegionsIds[(yBlock * _levelWidthBlocks) + xBlock];
+	}
+
+	/** Update the flow field after the player moved or after the level obstacles changed. */
+	static void _updateFlowField()
+	{
+		SDL_Rect *pointerPlayerRectangle = pointerPlayer->getPositionRectangle();
+		int xPlayerBlock = (pointerPlayerRectangle->x + (pointerPlayerRectangle->w / 2)) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yPlayerBlock = (pointerPlayerRectangle->y + (pointerPlayerRectangle->h / 2)) / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		unsigned int i;
+		
+		// A new obstacle can make some paths longer, which can't be repaired by a wavefront of decreasing distances. Walls are never built while playing, so simply compute the flow field again
+		for (i = 0; i < _changedObstaclesBlocksIndexes.size(); i++)
+		{
+			if (LevelManager::isObstacleBlock(_changedObstaclesBlocksIndexes[i] % _levelWidthBlocks, _changedObstaclesBlocksIndexes[i] / _levelWidthBlocks))
+			{
+				_flowFieldTargetBlockIndex = -1;
+				break;
+			}
+		}
+		
+		// All distances change when the player reaches another block
+		if (_flowFieldTargetBlockIndex != (yPlayerBlock * _levelWidthBlocks) + xPlayerBlock)
+		{
+			_computeFlowField(xPlayerBlock, yPlayerBlock);
+			return;
+		}
+		
+		// Destroyed enemy spawners free their block, only the paths going through it need to be updated
+		for (i = 0; i < _changedObstaclesBlocksIndexes.size(); i++) _repairFreedBlock(_changedObstaclesBlocksIndexes[i]);
+	}
+
+	void update()
+	{
+		unsigned int i;
+		
+		// Start from empty data when the level changed
+		if (LevelManager::getObstaclesChanges(&_changedObstaclesBlocksIndexes))
+		{
+			_levelWidthBlocks = LevelManager::getLevelWidthBlocks();
+			_levelHeightBlocks = LevelManager::getLevelHeightBlocks();
+			_flowFieldDistances.assign(_levelWidthBlocks * _levelHeightBlocks, FLOW_FIELD_UNREACHABLE_DISTANCE);
+			_reachedBlocksIndexes.clear();
+			_flowFieldTargetBlockIndex = -1;
+			_buildClustersGraph();
+			_labelRegions();
+		}
+		// Obstacles change only when enemy spawners are destroyed, so only the clusters graph and the regions around the freed blocks need to be updated
+		else if (!_changedObstaclesBlocksIndexes.empty())
+		{
+			// A new obstacle can split a region or make paths longer, which can't be repaired, so build everything again
+			for (i = 0; i < _changedObstaclesBlocksIndexes.size(); i++)
+			{
+				if (LevelManager::isObstacleBlock(_changedObstaclesBlocksIndexes[i] % _levelWidthBlocks, _changedObstaclesBlocksIndexes[i] / _levelWidthBlocks)) break;
+			}
+			if (i < _changedObstaclesBlocksIndexes.size())
+			{
+				_buildClustersGraph();
+				_labelRegions();
+			}
+			else
+			{
+				for (i = 0; i < _changedObstaclesBlocksIndexes.size(); i++)
+				{
+					_repairClustersGraph(_changedObstaclesBlocksIndexes[i]);
+					_mergeFreedBlockRegions(_changedObstaclesBlocksIndexes[i]);
+				}
+			}
+		}
+		
+		_updateFlowField();
+	}
+
+	int getFlowFieldDirection(int x, int y, MovingEntity::Direction *pointerDirection)
+	{
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int blockIndex, distance;
+		
+		if ((_flowFieldTargetBlockIndex == -1) || (x < 0) || (xBlock >= _levelWidthBlocks) || (y < 0) || (yBlock >= _levelHeightBlocks)) return 0;
+		
+		blockIndex = (yBlock * _levelWidthBlocks) + xBlock;
+		distance = _flowFieldDistances[blockIndex];
+		if ((distance == 0) || (distance == FLOW_FIELD_UNREACHABLE_DISTANCE)) return 0;
+		
+		// A reachable block always has a neighbor one block closer to the player, look for it in the directions order so the result does not depend on anything else
+		if ((yBlock > 0) && (_flowFieldDistances[blockIndex - _levelWidthBlocks] < distance)) *pointerDirection = MovingEntity::DIRECTION_UP;
+		else if ((yBlock < _levelHeightBlocks - 1) && (_flowFieldDistances[blockIndex + _levelWidthBlocks] < distance)) *pointerDirection = MovingEntity::DIRECTION_DOWN;
+		else if ((xBlock > 0) && (_flowFieldDistances[blockIndex - 1] < distance)) *pointerDirection = MovingEntity::DIRECTION_LEFT;
+		else *pointerDirection = MovingEntity::DIRECTION_RIGHT;
+		return 1;
+	}
+
+	int findPath(int xStartingBlock, int yStartingBlock, int xGoalBlock, int yGoalBlock, std::vector<int> *pointerPath)
+	{
+		int startingBlockIndex, goalBlockIndex, startingNodeIndex = _nodesCount, goalNodeIndex = _nodesCount + 1, nodeIndex, cost, i, distance;
+		std::vector<int> *pointerClusterNodesIndexes;
+		unsigned int j;
+		
+		pointerPath->clear();
+		if (LevelManager::isObstacleBlock(xStartingBlock, yStartingBlock) || LevelManager::isObstacleBlock(xGoalBlock, yGoalBlock)) return -1;
+		startingBlockIndex = (yStartingBlock * _levelWidthBlocks) + xStartingBlock;
+		goalBlockIndex = (yGoalBlock * _levelWidthBlocks) + xGoalBlock;
+		if (startingBlockIndex == goalBlockIndex) return 0;
+		if (_blocksRegionsIds[startingBlockIndex] != _blocksRegionsIds[goalBlockIndex]) return -1; // No need to search the whole graph to know the goal can't be reached
+		
+		// The starting and goal blocks are temporary nodes appended to the graph
+		_nodesCosts.assign(_nodesCount + 2, CLUSTERS_GRAPH_UNREACHABLE_COST);
+		_nodesParentsIndexes.assign(_nodesCount + 2, -1);
+		_nodesGoalCosts.assign(_nodesCount + 2, CLUSTERS_GRAPH_UNREACHABLE_COST);
+		_openNodes.clear();
+		
+		// Connect the goal to the nodes of its cluster
+		_computeClusterDistances(goalBlockIndex);
+		pointerClusterNodesIndexes = &_clustersNodesIndexes[_getBlockClusterIndex(goalBlockIndex)];
+		for (j = 0; j < pointerClusterNodesIndexes->size(); j++) _nodesGoalCosts[(*pointerClusterNodesIndexes)[j]] = _getClusterDistance(_nodesBlocksIndexes[(*pointerClusterNodesIndexes)[j]]);
+		_nodesGoalCosts[startingNodeIndex] = _getClusterDistance(startingBlockIndex); // Both blocks can be in the same cluster
+		
+		// Search the graph with A*, the starting node is expanded first so the distances inside its cluster are still available
+		_computeClusterDistances(startingBlockIndex);
+		_reachNode(startingNodeIndex, -1, 0, goalBlockIndex);
+		while (!_openNodes.empty())
+		{
+			std::pop_heap(_openNodes.begin(), _openNodes.end(), _isOpenNodeExpandedAfter);
+			nodeIndex = _openNodes.back().second;
+			cost = _openNodes.back().first;
+			_openNodes.pop_back();
+			if (nodeIndex == goalNodeIndex) break;
+			
+			// Skip the outdated entries of the nodes that were reached again with a shorter path
+			if (cost != _nodesCosts[nodeIndex] + ((nodeIndex < _nodesCount) ? _estimatePathCost(_nodesBlocksIndexes[nodeIndex], goalBlockIndex) : 0)) continue;
+			cost = _nodesCosts[nodeIndex];
+			
+			if (_nodesGoalCosts[nodeIndex] != CLUSTERS_GRAPH_UNREACHABLE_COST) _reachNode(goalNodeIndex, nodeIndex, cost + _nodesGoalCosts[nodeIndex], goalBlockIndex);
+			if (nodeIndex == startingNodeIndex)
+			{
+				pointerClusterNodesIndexes = &_clustersNodesIndexes[_getBlockClusterIndex(startingBlockIndex)];
+				for (j = 0; j < pointerClusterNodesIndexes->size(); j++)
+				{
+					distance = _getClusterDistance(_nodesBlocksIndexes[(*pointerClusterNodesIndexes)[j]]);
+					if (distance != CLUSTERS_GRAPH_UNREACHABLE_COST) _reachNode((*pointerClusterNodesIndexes)[j], nodeIndex, distance, goalBlockIndex);
+				}
+			}
+			else
+			{
+				for (j = 0; j < _nodesEdges[nodeIndex].size(); j++) _reachNode(_nodesEdges[nodeIndex][j].nodeIndex, nodeIndex, cost + _nodesEdges[nodeIndex][j].cost, goalBlockIndex);
+			}
+		}
+		if (_nodesCosts[goalNodeIndex] == CLUSTERS_GRAPH_UNREACHABLE_COST) return -1;
+		
+		// Walk the path back from the goal
+		pointerPath->push_back(goalBlockIndex);
+		for (i = _nodesParentsIndexes[goalNodeIndex]; i != startingNodeIndex; i = _nodesParentsIndexes[i]) pointerPath->push_back(_nodesBlocksIndexes[i]);
+		std::reverse(pointerPath->begin(), pointerPath->end());
+		return 0;
+	}
+
+	int getPathDirection(int x, int y, int goalX, int goalY, MovingEntity::Direction *pointerDirection)
+	{
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE, blockIndex, goalBlockIndex, waypointBlockIndex, distance;
+		CachedPath *pointerCachedPath;
+		unsigned int i;
+		
+		if ((x < 0) || (y < 0) || (goalX < 0) || (goalY < 0) || LevelManager::isObstacleBlock(xBlock, yBlock)) return 0;
+		blockIndex = (yBlock * _levelWidthBlocks) + xBlock;
+		goalBlockIndex = ((goalY / CONFIGURATION_LEVEL_BLOCK_SIZE) * _levelWidthBlocks) + (goalX / CONFIGURATION_LEVEL_BLOCK_SIZE);
+		if (blockIndex == goalBlockIndex) return 0;
+		
+		// Paths are remembered until the level obstacles change close enough to them
+		pointerCachedPath = &_pathsCache[(((unsigned int) blockIndex * 31) + (unsigned int) goalBlockIndex) & (CONFIGURATION_PATHFINDING_PATHS_CACHE_SIZE - 1)];
+		if ((pointerCachedPath->startingBlockIndex != blockIndex) || (pointerCachedPath->goalBlockIndex != goalBlockIndex))
+		{
+			pointerCachedPath->startingBlockIndex = blockIndex;
+			pointerCachedPath->goalBlockIndex = goalBlockIndex;
+			pointerCachedPath->direction = -1;
+			pointerCachedPath->cost = CLUSTERS_GRAPH_UNREACHABLE_COST;
+			
+			if (findPath(xBlock, yBlock, goalX / CONFIGURATION_LEVEL_BLOCK_SIZE, goalY / CONFIGURATION_LEVEL_BLOCK_SIZE, &_clusterBlocksQueue) == 0)
+			{
+				pointerCachedPath->cost = _nodesCosts[_nodesCount + 1]; // The goal node cost
+				
+				// The path goes through the starting block if it is a graph node, skip it
+				i = 0;
+				if (_clusterBlocksQueue[0] == blockIndex) i++;
+				waypointBlockIndex = _clusterBlocksQueue[i];
+				
+				// Only refine the path up to the first waypoint, which is on the other side of the cluster border or in the same cluster
+				if (waypointBlockIndex == blockIndex - _levelWidthBlocks) pointerCachedPath->direction = MovingEntity::DIRECTION_UP;
+				else if (waypointBlockIndex == blockIndex + _levelWidthBlocks) pointerCachedPath->direction = MovingEntity::DIRECTION_DOWN;
+				else if ((waypointBlockIndex == blockIndex - 1) && (xBlock > 0)) pointerCachedPath->direction = MovingEntity::DIRECTION_LEFT;
+				else if ((waypointBlockIndex == blockIndex + 1) && (xBlock < _levelWidthBlocks - 1)) pointerCachedPath->direction = MovingEntity::DIRECTION_RIGHT;
+				else
+				{
+					_computeClusterDistances(waypointBlockIndex);
+					distance = _getClusterDistance(blockIndex);
+					assert(distance != CLUSTERS_GRAPH_UNREACHABLE_COST);
+					if ((yBlock > 0) && (_getClusterDistance(blockIndex - _levelWidthBlocks) < distance)) pointerCachedPath->direction = MovingEntity::DIRECTION_UP;
+					else if ((yBlock < _levelHeightBlocks - 1) && (_getClusterDistance(blockIndex + _levelWidthBlocks) < distance)) pointerCachedPath->direction = MovingEntity::DIRECTION_DOWN;
+					else if ((xBlock > 0) && (_getClusterDistance(blockIndex - 1) < distance)) pointerCachedPath->direction = MovingEntity::DIRECTION_LEFT;
+					else pointerCachedPath->direction = MovingEntity::DIRECTION_RIGHT;
+				}
+			}
+		}
+		
+		if (pointerCachedPath->direction == -1) return 0;
+		*pointerDirection = (MovingEntity::Direction) pointerCachedPath->direction;
+		return 1;
+	}
+
+	bool isReachable(int x, int y, int goalX, int goalY)
+	{
+		int regionId = _getRegionId(x, y);
+		
+		return (regionId != -1) && (regionId == _getRegionId(goalX, goalY));
+	}
+
+	unsigned int getRegionsVersion()
+	{
+		return _regionsVersion;
+	}
+}
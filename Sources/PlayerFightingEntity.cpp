@@ -5,6 +5,7 @@
 #include <AudioManager.hpp>
 #include <Configuration.hpp>
 #include <EffectManager.hpp>
+#include <GameClock.hpp>
 #include <HeadUpDisplay.hpp>
 #include <LevelManager.hpp>
 #include <Log.hpp>
@@ -21,10 +22,11 @@ PlayerFightingEntity::PlayerFightingEntity(int x, int y): FightingEntity(x, y, T
 	_renderingY = (Renderer::displayHeight - pointerPositionRectangle->h) / 2;
 	
 	_ammunitionAmount = CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_AMMUNITION_AMOUNT;
+	_homingRocketsAmount = 0;
 	
 	// Allow to shoot immediately
 	_secondaryFireTimeBetweenShots = 9500; // Slightly faster than a big enemy reloading time
-	_secondaryFireLastShotTime = -_secondaryFireTimeBetweenShots;
+	_secondaryFireLastShotTime = GameClock::getTime() - _secondaryFireTimeBetweenShots;
 	
 	// Cache bullet and firing effect position offsets
 	_computeBulletStartingPositionOffsets(_pointerTextures[DIRECTION_UP], TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_BULLET_MORTAR_SHELL_FACING_UP), _secondaryFireStartingPositionOffsets);
@@ -86,6 +88,14 @@ BulletMovingEntity *PlayerFightingEntity::shootSecondaryFire()
 		
 		// Create the bullet
 		BulletMovingEntity *pointerBullet = new BulletMovingEntity(entityX + bulletStartingPositionOffsetX, entityY + bulletStartingPositionOffsetY, TextureManager::TEXTURE_ID_PLAYER_BULLET_MORTAR_SHELL_FACING_UP, 4, _facingDirection, 20, 1);
+		pointerBullet->enableSplashDamage(CONFIGURATION_GAMEPLAY_MORTAR_SHELL_SPLASH_RADIUS, CONFIGURATION_GAMEPLAY_MORTAR_SHELL_SPLASH_DAMAGE_AMOUNT);
+		
+		// Shoot a homing rocket instead of a plain mortar shell if possible
+		if (_homingRocketsAmount > 0)
+		{
+			pointerBullet->enableHoming();
+			_homingRocketsAmount--;
+		}
 		
 		_ammunitionAmount -= CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT;
 		
@@ -94,9 +104,8 @@ BulletMovingEntity *PlayerFightingEntity::shootSecondaryFire()
 		// There are enough ammunition to also play the reloading effect (it can be started at the same time that the firing sound because there is a purposely added delay in reloading sound)
 		if (_ammunitionAmount >= CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) AudioManager::playSound(AudioManager::SOUND_ID_PLAYER_MORTAR_SHELL_RELOADING);
 		
-		// Get time after having generated the bullet, in case this takes more than 1 millisecond
 		_isSecondaryShootReloadingTimeElapsed = false;
-		_secondaryFireLastShotTime = SDL_GetTicks();
+		_secondaryFireLastShotTime = GameClock::getTime();
 		
 		return pointerBullet;
 	}
@@ -113,7 +122,7 @@ void PlayerFightingEntity::render()
 int PlayerFightingEntity::update()
 {
 	// Check whether the mortar reloading time has elapsed
-	if (SDL_GetTicks() - _secondaryFireLastShotTime >= _secondaryFireTimeBetweenShots) _isSecondaryShootReloadingTimeElapsed = true;
+	if (GameClock::getTime() - _secondaryFireLastShotTime >= _secondaryFireTimeBetweenShots) _isSecondaryShootReloadingTimeElapsed = true;
 	
 	// Update mortar HUD state
 	if (_ammunitionAmount < CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_LOW_AMMUNITION);
@@ -126,7 +135,7 @@ int PlayerFightingEntity::update()
 	// Handle bonus
 	if (_bonusRemainingTime > 0)
 	{
-		HeadUpDisplay::setRemainingBonusTime(((_bonusRemainingTime * CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS) / 1000) + 1); // Convert frame time to seconds, add one more second to compensate for integer computation rounding
+		HeadUpDisplay::setRemainingBonusTime(((_bonusRemainingTime * CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS) / 1000) + 1); // Convert ticks count to seconds, add one more second to compensate for integer computation rounding
 		_bonusRemainingTime--;
 	}
 	else
@@ -211,7 +220,7 @@ int PlayerFightingEntity::update()
 		if (_bonusRemainingTime == 0)
 		{
 			// Configure bonus
-			_bonusRemainingTime = 30000 / CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 30s (this method is called each game frame, so adjust time)
+			_bonusRemainingTime = 30000 / CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 30s (this method is called each game logic tick, so adjust time)
 			_timeBetweenShots = CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS / 3; // Make shoots three times faster
 			_currentActiveBonus = BONUS_MACHINE_GUN;
 			
@@ -238,7 +247,7 @@ int PlayerFightingEntity::update()
 		if (_bonusRemainingTime == 0)
 		{
 			// Configure bonus
-			_bonusRemainingTime = 45000 / CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 45s (this method is called each game frame, so adjust time)
+			_bonusRemainingTime = 45000 / CONFIGURATION_GAME_LOGIC_TICK_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 45s (this method is called each game logic tick, so adjust time)
 			_currentActiveBonus = BONUS_BULLETPROOF_VEST;
 			
 			EffectManager::addEffect(blockX, blockY, EffectManager::EFFECT_ID_BULLETPROOF_VEST_TAKEN);
@@ -255,12 +264,69 @@ int PlayerFightingEntity::update()
 			LevelManager::setBlockContent(playerCenterX, playerCenterY, blockContent);
 		}
 	}
+	// Are there homing rockets ?
+	else if (blockContent & LevelManager::BLOCK_CONTENT_HOMING_ROCKETS)
+	{
+		LOG_DEBUG("Player is crossing a block containing homing rockets.");
+		
+		_homingRocketsAmount += CONFIGURATION_GAMEPLAY_HOMING_ROCKETS_ITEM_ROCKETS_AMOUNT;
+		EffectManager::addEffect(blockX, blockY, EffectManager::EFFECT_ID_AMMUNITION_TAKEN); // There is no dedicated effect, homing rockets are a kind of ammunition
+		LOG_DEBUG("Player got homing rockets.");
+		
+		// Remove the homing rockets item
+		blockContent &= ~LevelManager::BLOCK_CONTENT_HOMING_ROCKETS;
+		LevelManager::setBlockContent(playerCenterX, playerCenterY, blockContent);
+	}
 	// Is it the level end ?
 	else if (blockContent & LevelManager::BLOCK_CONTENT_LEVEL_EXIT) return 2;
 	
 	return 0;
 }
 
+void PlayerFightingEntity::saveState(Snapshot *pointerSnapshot)
+{
+	FightingEntity::saveState(pointerSnapshot);
+	
+	pointerSnapshot->writeInteger(_ammunitionAmount);
+	pointerSnapshot->writeInteger(_homingRocketsAmount);
+	pointerSnapshot->writeUnsignedInteger(_secondaryFireLastShotTime);
+	pointerSnapshot->writeInteger(_isSecondaryShootReloadingTimeElapsed);
+	pointerSnapshot->writeInteger(_bonusRemainingTime);
+	pointerSnapshot->writeInteger(_currentActiveBonus);
+}
+
+void PlayerFightingEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	TextureManager::TextureId facingUpTextureId;
+	
+	FightingEntity::restoreState(pointerSnapshot);
+	
+	_ammunitionAmount = pointerSnapshot->readInteger();
+	_homingRocketsAmount = pointerSnapshot->readInteger();
+	_secondaryFireLastShotTime = pointerSnapshot->readUnsignedInteger();
+	_isSecondaryShootReloadingTimeElapsed = pointerSnapshot->readInteger();
+	_bonusRemainingTime = pointerSnapshot->readInteger();
+	_currentActiveBonus = (Bonus) pointerSnapshot->readInteger();
+	
+	// Wear the skin of the active bonus
+	switch (_currentActiveBonus)
+	{
+		case BONUS_MACHINE_GUN:
+			facingUpTextureId = TextureManager::TEXTURE_ID_PLAYER_MACHINE_GUN_BONUS_FACING_UP;
+			break;
+			
+		case BONUS_BULLETPROOF_VEST:
+			facingUpTextureId = TextureManager::TEXTURE_ID_PLAYER_BULLETPROOF_VEST_BONUS_FACING_UP;
+			break;
+			
+		default:
+			_currentActiveBonus = BONUS_NONE;
+			facingUpTextureId = TextureManager::TEXTURE_ID_PLAYER_FACING_UP;
+			break;
+	}
+	for (int i = 0; i < DIRECTIONS_COUNT; i++) _pointerTextures[i] = TextureManager::getTextureFromId((TextureManager::TextureId) (facingUpTextureId + i)); // Facing down, left and right textures follow the facing up one
+}
+
 BulletMovingEntity *PlayerFightingEntity::_fireBullet(int x, int y)
 {
 	return new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_PLAYER_BULLET_FACING_UP, 6, _facingDirection, 1, 1);
@@ -0,0 +1,123 @@
+/** @file RandomManager.cpp
+ * See RandomManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <cassert>
+#include <cstdint>
+#include <Log.hpp>
+#include <RandomManager.hpp>
+#include <SDL2/SDL.h>
+
+namespace RandomManager
+{
+	/** The xoshiro128** generator state of each stream (each thread has its own streams). The STREAM_ID_AUDIO entry is not used. */
+	static thread_local uint32_t _streamsStates[STREAM_IDS_COUNT][4];
+	/** The STREAM_ID_AUDIO generator state. The music is chosen by the audio thread, which never seeds its own streams, so this stream is shared by all threads. */
+	static uint32_t _audioStreamState[4];
+	/** Protect _audioStreamState from concurrent accesses. */
+	static SDL_SpinLock _audioStreamLock = 0;
+
+	/** Get the generator state of a stream. Lock _audioStreamLock before accessing the STREAM_ID_AUDIO state.
+	* @param streamId The stream.
+	* @return The stream state.
+	*/
+	static inline uint32_t *_getStreamState(int streamId)
+	{
+		if (streamId == STREAM_ID_AUDIO) return _audioStreamState;
+		return _streamsStates[streamId];
+	}
+
+	/** Rotate a 32-bit value to the left.
+	* @param value The value to rotate.
+	* @param bitsCount By how many bits to rotate, it must be in range [1; 31].
+	* @return The rotated value.
+	*/
+	static inline uint32_t _rotateLeft(uint32_t value, int bitsCount)
+	{
+		return (value << bitsCount) | (value >> (32 - bitsCount));
+	}
+
+	/** Generate the next value of the splitmix64 sequence, which is used to turn a single seed into well distributed xoshiro states.
+	* @param pointerState The splitmix64 state, it is updated.
+	* @return The generated value.
+	*/
+	static uint64_t _generateSplitMixValue(uint64_t *pointerState)
+	{
+		uint64_t value;
+		
+		*pointerState += 0x9E3779B97F4A7C15ULL;
+		value = *pointerState;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+
+	void initialize(unsigned int seed)
+	{
+		uint64_t splitMixState, value;
+		uint32_t *pointerState;
+		
+		SDL_AtomicLock(&_audioStreamLock);
+		for (int i = 0; i < STREAM_IDS_COUNT; i++)
+		{
+			// Give each stream its own starting point, so two streams never produce the same sequence
+			pointerState = _getStreamState(i);
+			splitMixState = ((uint64_t) seed << 32) | i;
+			value = _generateSplitMixValue(&splitMixState);
+			pointerState[0] = (uint32_t) value;
+			pointerState[1] = (uint32_t) (value >> 32);
+			value = _generateSplitMixValue(&splitMixState); // splitmix64 never returns two zero values in a row, so the state can't be all zeros
+			pointerState[2] = (uint32_t) value;
+			pointerState[3] = (uint32_t) (value >> 32);
+		}
+		SDL_AtomicUnlock(&_audioStreamLock);
+		
+		LOG_DEBUG("Random numbers streams seeded with %u.", seed);
+	}
+
+	int generateNumber(StreamId streamId, int maximumValue)
+	{
+		// Make sure parameters are correct
+		assert(streamId < STREAM_IDS_COUNT);
+		assert(maximumValue > 0);
+		
+		// The audio stream is shared with the audio thread
+		if (streamId == STREAM_ID_AUDIO) SDL_AtomicLock(&_audioStreamLock);
+		
+		// Compute the next xoshiro128** value
+		uint32_t *pointerState = _getStreamState(streamId);
+		uint32_t value = _rotateLeft(pointerState[1] * 5, 7) * 9;
+		uint32_t temporary = pointerState[1] << 9;
+		pointerState[2] ^= pointerState[0];
+		pointerState[3] ^= pointerState[1];
+		pointerState[1] ^= pointerState[2];
+		pointerState[0] ^= pointerState[3];
+		pointerState[2] ^= temporary;
+		pointerState[3] = _rotateLeft(pointerState[3], 11);
+		
+		if (streamId == STREAM_ID_AUDIO) SDL_AtomicUnlock(&_audioStreamLock);
+		
+		// Scale the value to the requested range with a multiplication, which is faster than a modulo and uses the value most significant bits (the best distributed ones)
+		return (int) (((uint64_t) value * (uint32_t) maximumValue) >> 32);
+	}
+
+	void saveState(Snapshot *pointerSnapshot)
+	{
+		SDL_AtomicLock(&_audioStreamLock);
+		for (int i = 0; i < STREAM_IDS_COUNT; i++)
+		{
+			for (int j = 0; j < 4; j++) pointerSnapshot->writeUnsignedInteger(_getStreamState(i)[j]);
+		}
+		SDL_AtomicUnlock(&_audioStreamLock);
+	}
+
+	void restoreState(Snapshot *pointerSnapshot)
+	{
+		SDL_AtomicLock(&_audioStreamLock);
+		for (int i = 0; i < STREAM_IDS_COUNT; i++)
+		{
+			for (int j = 0; j < 4; j++) _getStreamState(i)[j] = pointerSnapshot->readUnsignedInteger();
+		}
+		SDL_AtomicUnlock(&_audioStreamLock);
+	}
+}
@@ -0,0 +1,140 @@
+/** @file RectanglesBatch.cpp
+ * See RectanglesBatch.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <RectanglesBatch.hpp>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
+
+void RectanglesBatch::clear()
+{
+	_x.clear();
+	_y.clear();
+	_widths.clear();
+	_heights.clear();
+}
+
+int RectanglesBatch::add(SDL_Rect *pointerRectangle)
+{
+	_x.push_back(pointerRectangle->x);
+	_y.push_back(pointerRectangle->y);
+	_widths.push_back(pointerRectangle->w);
+	_heights.push_back(pointerRectangle->h);
+	return (int) _x.size() - 1;
+}
+
+void RectanglesBatch::get(int index, SDL_Rect *pointerRectangle)
+{
+	pointerRectangle->x = _x[index];
+	pointerRectangle->y = _y[index];
+	pointerRectangle->w = _widths[index];
+	pointerRectangle->h = _heights[index];
+}
+
+void RectanglesBatch::setPosition(int index, int x, int y)
+{
+	_x[index] = x;
+	_y[index] = y;
+}
+
+void RectanglesBatch::move(int index, int offsetX, int offsetY)
+{
+	_x[index] += offsetX;
+	_y[index] += offsetY;
+}
+
+void RectanglesBatch::moveAll(int offsetX, int offsetY)
+{
+	int i, count = (int) _x.size();
+	
+	// The compiler vectorizes this loop by itself
+	for (i = 0; i < count; i++)
+	{
+		_x[i] += offsetX;
+		_y[i] += offsetY;
+	}
+}
+
+unsigned int RectanglesBatch::_computeRangeIntersectionsMask(SDL_Rect *pointerRectangle, int startingIndex, int count)
+{
+	unsigned int mask = 0;
+	int i = 0, rectangleX, rectangleY;
+	int left = pointerRectangle->x, top = pointerRectangle->y, right = pointerRectangle->x + pointerRectangle->w, bottom = pointerRectangle->y + pointerRectangle->h;
+	
+	// Like SDL_HasIntersection(), an empty rectangle does not intersect with anything
+	if ((pointerRectangle->w <= 0) || (pointerRectangle->h <= 0)) return 0;
+	
+	// Two rectangles intersect when each one starts before the other one ends, on both axis
+	#ifdef __AVX2__
+		__m256i left8 = _mm256_set1_epi32(left), top8 = _mm256_set1_epi32(top), right8 = _mm256_set1_epi32(right), bottom8 = _mm256_set1_epi32(bottom), zero8 = _mm256_setzero_si256();
+		__m256i x8, y8, widths8, heights8, result8;
+		for (; i + 8 <= count; i += 8)
+		{
+			x8 = _mm256_loadu_si256((__m256i *) &_x[startingIndex + i]);
+			y8 = _mm256_loadu_si256((__m256i *) &_y[startingIndex + i]);
+			widths8 = _mm256_loadu_si256((__m256i *) &_widths[startingIndex + i]);
+			heights8 = _mm256_loadu_si256((__m256i *) &_heights[startingIndex + i]);
+			
+			result8 = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_add_epi32(x8, widths8), left8), _mm256_cmpgt_epi32(right8, x8));
+			result8 = _mm256_and_si256(result8, _mm256_cmpgt_epi32(_mm256_add_epi32(y8, heights8), top8));
+			result8 = _mm256_and_si256(result8, _mm256_cmpgt_epi32(bottom8, y8));
+			result8 = _mm256_and_si256(result8, _mm256_and_si256(_mm256_cmpgt_epi32(widths8, zero8), _mm256_cmpgt_epi32(heights8, zero8)));
+			mask |= (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(result8)) << i;
+		}
+	#endif
+	#ifdef __SSE2__
+		__m128i left4 = _mm_set1_epi32(left), top4 = _mm_set1_epi32(top), right4 = _mm_set1_epi32(right), bottom4 = _mm_set1_epi32(bottom), zero4 = _mm_setzero_si128();
+		__m128i x4, y4, widths4, heights4, result4;
+		for (; i + 4 <= count; i += 4)
+		{
+			x4 = _mm_loadu_si128((__m128i *) &_x[startingIndex + i]);
+			y4 = _mm_loadu_si128((__m128i *) &_y[startingIndex + i]);
+			widths4 = _mm_loadu_si128((__m128i *) &_widths[startingIndex + i]);
+			heights4 = _mm_loadu_si128((__m128i *) &_heights[startingIndex + i]);
+			
+			result4 = _mm_and_si128(_mm_cmpgt_epi32(_mm_add_epi32(x4, widths4), left4), _mm_cmpgt_epi32(right4, x4));
+			result4 = _mm_and_si128(result4, _mm_cmpgt_epi32(_mm_add_epi32(y4, heights4), top4));
+			result4 = _mm_and_si128(result4, _mm_cmpgt_epi32(bottom4, y4));
+			result4 = _mm_and_si128(result4, _mm_and_si128(_mm_cmpgt_epi32(widths4, zero4), _mm_cmpgt_epi32(heights4, zero4)));
+			mask |= (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(result4)) << i;
+		}
+	#endif
+	
+	// Test the remaining rectangles one by one
+	for (; i < count; i++)
+	{
+		rectangleX = _x[startingIndex + i];
+		rectangleY = _y[startingIndex + i];
+		if ((_widths[startingIndex + i] > 0) && (_heights[startingIndex + i] > 0) && (rectangleX + _widths[startingIndex + i] > left) && (rectangleX < right) && (rectangleY + _heights[startingIndex + i] > top) && (rectangleY < bottom)) mask |= 1u << i;
+	}
+	
+	return mask;
+}
+
+int RectanglesBatch::findFirstIntersection(SDL_Rect *pointerRectangle, int startingIndex)
+{
+	int i, count = (int) _x.size(), rangeCount;
+	unsigned int mask;
+	
+	// Test 32 rectangles at a time, so the mask holds all results of a range
+	for (i = startingIndex; i < count; i += 32)
+	{
+		rangeCount = count - i;
+		if (rangeCount > 32) rangeCount = 32;
+		
+		mask = _computeRangeIntersectionsMask(pointerRectangle, i, rangeCount);
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+	
+	return -1;
+}
+
+unsigned int RectanglesBatch::computeIntersectionsMask(SDL_Rect *pointerRectangle)
+{
+	int count = (int) _x.size();
+	
+	if (count > 32) count = 32;
+	return _computeRangeIntersectionsMask(pointerRectangle, 0, count);
+}
@@ -15,7 +15,8 @@
 	#include <SDL2/SDL_ttf.h>
 #endif
 
-#include <emscripten.h>
+#ifdef __EMSCRIPTEN__
+	#include <emscripten.h>
 
 EM_JS(bool, shouldRenderWASM, (), {
   return shouldRenderJSSide();
@@ -24,6 +25,7 @@ EM_JS(bool, shouldRenderWASM, (), {
 EM_JS(void, didRenderingWASM, (), {
 	didRendering();
 });
+#endif
 
 namespace Renderer
 {
@@ -41,15 +43,18 @@ namespace Renderer
 	static unsigned int _framecount = 0;
 
 	// Public variable, documentation is in the header file
-	SDL_Renderer *pointerRenderer;
+	SDL_Renderer *pointerRenderer = NULL;
 
 	// Public variables, documentation is in the header file
 	int displayX;
 	int displayY;
 
-	// Public variables, documentation is in the header file
-	int displayWidth;
-	int displayHeight;
+	// Public variable, documentation is in the header file
+	float ticksInterpolationFactor = 1;
+
+	// Public variables, documentation is in the header file (default to the windowed mode size, which is kept when no window is created in headless mode)
+	int displayWidth = CONFIGURATION_DISPLAY_WIDTH;
+	int displayHeight = CONFIGURATION_DISPLAY_HEIGHT;
 
 	int initialize(bool isFullScreenEnabled)
 	{
@@ -203,11 +208,15 @@ namespace Renderer
 	void endFrame()
 	{
 		// Display the rendered picture
-		while (!shouldRenderWASM()) {
-			emscripten_sleep(0);
-		}
+		#ifdef __EMSCRIPTEN__
+			while (!shouldRenderWASM()) {
+				emscripten_sleep(0);
+			}
+		#endif
 		SDL_RenderPresent(pointerRenderer);
-		didRenderingWASM();
+		#ifdef __EMSCRIPTEN__
+			didRenderingWASM();
+		#endif
 		_framecount++;
 
 
@@ -220,6 +229,9 @@ namespace Renderer
 		assert(colorId < TEXT_COLOR_IDS_COUNT);
 		assert(fontSizeId < FONT_SIZE_IDS_COUNT);
 		
+		// Nothing can be rendered in headless mode
+		if (pointerRenderer == NULL) return NULL;
+		
 		// Render the text
 		SDL_Surface *pointerSurface = TTF_RenderText_Blended(_pointerFonts[fontSizeId], pointerStringText, _textColors[colorId]);
 		if (pointerSurface == NULL)
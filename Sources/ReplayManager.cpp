@@ -0,0 +1,201 @@
+/** @file ReplayManager.cpp
+ * See ReplayManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <cstdio>
+#include <cstring>
+#include <Log.hpp>
+#include <ReplayManager.hpp>
+
+namespace ReplayManager
+{
+	/** Identify a replay file. */
+	static const char REPLAY_FILE_MAGIC[4] = { 'S', 'R', 'P', 'L' };
+	/** Increment this value each time the file format or the game logic changes in a way that makes previous replays diverge. */
+	static const unsigned int REPLAY_FILE_VERSION = 9;
+
+	/** The file being recorded by the calling thread. */
+	static thread_local FILE *_pointerRecordingFile = NULL;
+	/** The file being played by the calling thread. */
+	static thread_local FILE *_pointerPlaybackFile = NULL;
+
+	/** Write a 32-bit value in little endian, so replay files can be exchanged between all platforms.
+	* @param pointerFile The file to write to.
+	* @param value The value to write.
+	* @return 0 if the value was successfully written,
+	* @return -1 if an error occurred.
+	*/
+	static int _writeUnsignedInteger(FILE *pointerFile, unsigned int value)
+	{
+		unsigned char bytes[4];
+		
+		for (int i = 0; i < 4; i++) bytes[i] = (unsigned char) (value >> (i * 8));
+		if (fwrite(bytes, 1, sizeof(bytes), pointerFile) != sizeof(bytes)) return -1;
+		return 0;
+	}
+
+	/** Read a 32-bit value stored in little endian.
+	* @param pointerFile The file to read from.
+	* @param pointerValue On output, contain the read value.
+	* @return 0 if the value was successfully read,
+	* @return -1 if the end of the file was reached or if an error occurred.
+	*/
+	static int _readUnsignedInteger(FILE *pointerFile, unsigned int *pointerValue)
+	{
+		unsigned char bytes[4];
+		
+		if (fread(bytes, 1, sizeof(bytes), pointerFile) != sizeof(bytes)) return -1;
+		*pointerValue = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int) bytes[3] << 24);
+		return 0;
+	}
+
+	int startRecording(const char *pointerStringFileName, ReplayHeader *pointerHeader)
+	{
+		int i;
+		unsigned int headerValues[] =
+		{
+			pointerHeader->randomSeed,
+			(unsigned int) pointerHeader->levelNumber,
+			(unsigned int) pointerHeader->playerMaximumLifePoints,
+			(unsigned int) pointerHeader->playerAmmunition,
+			(unsigned int) pointerHeader->displayWidth,
+			(unsigned int) pointerHeader->displayHeight
+		};
+		
+		stopRecording();
+		
+		// Try to create the file
+		_pointerRecordingFile = fopen(pointerStringFileName, "wb");
+		if (_pointerRecordingFile == NULL)
+		{
+			LOG_ERROR("Could not create replay file '%s'.", pointerStringFileName);
+			return -1;
+		}
+		
+		// Write the header
+		if (fwrite(REPLAY_FILE_MAGIC, 1, sizeof(REPLAY_FILE_MAGIC), _pointerRecordingFile) != sizeof(REPLAY_FILE_MAGIC)) goto Exit_Error;
+		if (_writeUnsignedInteger(_pointerRecordingFile, REPLAY_FILE_VERSION) != 0) goto Exit_Error;
+		for (i = 0; i < (int) (sizeof(headerValues) / sizeof(headerValues[0])); i++)
+		{
+			if (_writeUnsignedInteger(_pointerRecordingFile, headerValues[i]) != 0) goto Exit_Error;
+		}
+		
+		LOG_INFORMATION("Started recording replay file '%s' (random seed %u, level %d).", pointerStringFileName, pointerHeader->randomSeed, pointerHeader->levelNumber);
+		return 0;
+	
+	Exit_Error:
+		LOG_ERROR("Failed to write replay file '%s' header.", pointerStringFileName);
+		fclose(_pointerRecordingFile);
+		_pointerRecordingFile = NULL;
+		return -1;
+	}
+
+	void recordTick(unsigned int keysState, unsigned int worldHash)
+	{
+		unsigned char keysBytes[2];
+		
+		if (_pointerRecordingFile == NULL) return;
+		
+		// Only 16 bits are needed to store the keys state
+		keysBytes[0] = (unsigned char) keysState;
+		keysBytes[1] = (unsigned char) (keysState >> 8);
+		if ((fwrite(keysBytes, 1, sizeof(keysBytes), _pointerRecordingFile) != sizeof(keysBytes)) || (_writeUnsignedInteger(_pointerRecordingFile, worldHash) != 0))
+		{
+			LOG_ERROR("Failed to write replay tick, stopping recording.");
+			stopRecording();
+		}
+	}
+
+	void stopRecording()
+	{
+		if (_pointerRecordingFile == NULL) return;
+		
+		fclose(_pointerRecordingFile);
+		_pointerRecordingFile = NULL;
+		LOG_INFORMATION("Stopped recording replay.");
+	}
+
+	bool isRecording()
+	{
+		return _pointerRecordingFile != NULL;
+	}
+
+	int startPlayback(const char *pointerStringFileName, ReplayHeader *pointerHeader)
+	{
+		char magic[sizeof(REPLAY_FILE_MAGIC)];
+		unsigned int version, headerValues[6];
+		int i;
+		
+		stopPlayback();
+		
+		// Try to open the file
+		_pointerPlaybackFile = fopen(pointerStringFileName, "rb");
+		if (_pointerPlaybackFile == NULL)
+		{
+			LOG_ERROR("Could not open replay file '%s'.", pointerStringFileName);
+			return -1;
+		}
+		
+		// Make sure this is a replay file this game version can play
+		if ((fread(magic, 1, sizeof(magic), _pointerPlaybackFile) != sizeof(magic)) || (memcmp(magic, REPLAY_FILE_MAGIC, sizeof(magic)) != 0))
+		{
+			LOG_ERROR("File '%s' is not a replay file.", pointerStringFileName);
+			goto Exit_Error;
+		}
+		if ((_readUnsignedInteger(_pointerPlaybackFile, &version) != 0) || (version != REPLAY_FILE_VERSION))
+		{
+			LOG_ERROR("Replay file '%s' version is not supported (expected version %u).", pointerStringFileName, REPLAY_FILE_VERSION);
+			goto Exit_Error;
+		}
+		
+		// Retrieve the game starting conditions
+		for (i = 0; i < (int) (sizeof(headerValues) / sizeof(headerValues[0])); i++)
+		{
+			if (_readUnsignedInteger(_pointerPlaybackFile, &headerValues[i]) != 0)
+			{
+				LOG_ERROR("Replay file '%s' header is truncated.", pointerStringFileName);
+				goto Exit_Error;
+			}
+		}
+		pointerHeader->randomSeed = headerValues[0];
+		pointerHeader->levelNumber = (int) headerValues[1];
+		pointerHeader->playerMaximumLifePoints = (int) headerValues[2];
+		pointerHeader->playerAmmunition = (int) headerValues[3];
+		pointerHeader->displayWidth = (int) headerValues[4];
+		pointerHeader->displayHeight = (int) headerValues[5];
+		
+		LOG_INFORMATION("Started playing replay file '%s' (random seed %u, level %d).", pointerStringFileName, pointerHeader->randomSeed, pointerHeader->levelNumber);
+		return 0;
+	
+	Exit_Error:
+		fclose(_pointerPlaybackFile);
+		_pointerPlaybackFile = NULL;
+		return -1;
+	}
+
+	int playTick(unsigned int *pointerKeysState, unsigned int *pointerWorldHash)
+	{
+		unsigned char keysBytes[2];
+		
+		if (_pointerPlaybackFile == NULL) return 1;
+		
+		// A partially written tick is considered as the end of the replay
+		if ((fread(keysBytes, 1, sizeof(keysBytes), _pointerPlaybackFile) != sizeof(keysBytes)) || (_readUnsignedInteger(_pointerPlaybackFile, pointerWorldHash) != 0)) return 1;
+		*pointerKeysState = keysBytes[0] | (keysBytes[1] << 8);
+		
+		return 0;
+	}
+
+	void stopPlayback()
+	{
+		if (_pointerPlaybackFile == NULL) return;
+		
+		fclose(_pointerPlaybackFile);
+		_pointerPlaybackFile = NULL;
+	}
+
+	bool isPlaying()
+	{
+		return _pointerPlaybackFile != NULL;
+	}
+}
@@ -10,6 +10,11 @@ SmallEnemyFightingEntity::SmallEnemyFightingEntity(int x, int y): EnemyFightingE
 
 SmallEnemyFightingEntity::~SmallEnemyFightingEntity() {}
 
+EnemyFightingEntity::EnemyType SmallEnemyFightingEntity::getType()
+{
+	return ENEMY_TYPE_SMALL;
+}
+
 BulletMovingEntity *SmallEnemyFightingEntity::_fireBullet(int x, int y)
 {
 	return new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_SMALL_ENEMY_BULLET_FACING_UP, 6, _facingDirection, 1, 0);
@@ -0,0 +1,113 @@
+/** @file Snapshot.cpp
+ * See Snapshot.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <Log.hpp>
+#include <Snapshot.hpp>
+
+Snapshot::Snapshot()
+{
+	_readingOffset = 0;
+	_isReadingFailed = false;
+}
+
+void Snapshot::beginWriting()
+{
+	_data.clear();
+}
+
+void Snapshot::writeInteger(int value)
+{
+	writeUnsignedInteger((unsigned int) value);
+}
+
+void Snapshot::writeUnsignedInteger(unsigned int value)
+{
+	_data.push_back((unsigned char) value);
+	_data.push_back((unsigned char) (value >> 8));
+	_data.push_back((unsigned char) (value >> 16));
+	_data.push_back((unsigned char) (value >> 24));
+}
+
+void Snapshot::beginReading()
+{
+	_readingOffset = 0;
+	_isReadingFailed = false;
+}
+
+int Snapshot::readInteger()
+{
+	return (int) readUnsignedInteger();
+}
+
+unsigned int Snapshot::readUnsignedInteger()
+{
+	// Do not read beyond the snapshot end
+	if (_readingOffset + 4 > _data.size())
+	{
+		_isReadingFailed = true;
+		return 0;
+	}
+	
+	unsigned char *pointerBytes = &_data[_readingOffset];
+	_readingOffset += 4;
+	return pointerBytes[0] | (pointerBytes[1] << 8) | (pointerBytes[2] << 16) | ((unsigned int) pointerBytes[3] << 24);
+}
+
+int Snapshot::saveToFile(const char *pointerStringFileName)
+{
+	// Try to create the file
+	FILE *pointerFile = fopen(pointerStringFileName, "wb");
+	if (pointerFile == NULL)
+	{
+		LOG_ERROR("Could not create snapshot file '%s' (%s).", pointerStringFileName, strerror(errno));
+		return -1;
+	}
+	
+	if (fwrite(_data.data(), 1, _data.size(), pointerFile) != _data.size())
+	{
+		LOG_ERROR("Failed to write snapshot file '%s'.", pointerStringFileName);
+		fclose(pointerFile);
+		return -1;
+	}
+	
+	fclose(pointerFile);
+	return 0;
+}
+
+int Snapshot::loadFromFile(const char *pointerStringFileName)
+{
+	unsigned char buffer[4096];
+	size_t readBytesCount;
+	
+	_data.clear();
+	
+	// Try to open the file
+	FILE *pointerFile = fopen(pointerStringFileName, "rb");
+	if (pointerFile == NULL)
+	{
+		LOG_ERROR("Could not open snapshot file '%s' (%s).", pointerStringFileName, strerror(errno));
+		return -1;
+	}
+	
+	// Load the whole file
+	do
+	{
+		readBytesCount = fread(buffer, 1, sizeof(buffer), pointerFile);
+		_data.insert(_data.end(), buffer, buffer + readBytesCount);
+	} while (readBytesCount == sizeof(buffer));
+	
+	if (ferror(pointerFile))
+	{
+		LOG_ERROR("Failed to read snapshot file '%s'.", pointerStringFileName);
+		fclose(pointerFile);
+		_data.clear();
+		return -1;
+	}
+	
+	fclose(pointerFile);
+	return 0;
+}
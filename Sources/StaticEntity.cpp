@@ -49,3 +49,15 @@ SDL_Rect *StaticEntity::getPositionRectangle()
 {
 	return &_positionRectangle;
 }
+
+void StaticEntity::saveState(Snapshot *pointerSnapshot)
+{
+	pointerSnapshot->writeInteger(_positionRectangle.x);
+	pointerSnapshot->writeInteger(_positionRectangle.y);
+}
+
+void StaticEntity::restoreState(Snapshot *pointerSnapshot)
+{
+	_positionRectangle.x = pointerSnapshot->readInteger();
+	_positionRectangle.y = pointerSnapshot->readInteger();
+}
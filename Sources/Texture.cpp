@@ -20,6 +20,13 @@ Texture::Texture(SDL_Texture *pointerSDLTexture)
 	}
 }
 
+Texture::Texture(SDL_Texture *pointerSDLTexture, int width, int height)
+{
+	_pointerSDLTexture = pointerSDLTexture;
+	_width = width;
+	_height = height;
+}
+
 int Texture::render(int x, int y)
 {
 	SDL_Rect positionRectangle;
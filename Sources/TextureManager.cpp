@@ -1190,17 +1190,21 @@ namespace TextureManager
 				return -1;
 			}
 			
-			// Convert the surface to a texture
-			_texturesInformations[i].pointerSDLTexture = SDL_CreateTextureFromSurface(Renderer::pointerRenderer, pointerSurface);
-			SDL_FreeSurface(pointerSurface);
-			if (_texturesInformations[i].pointerSDLTexture == NULL)
+			// Convert the surface to a texture if something can be displayed, only texture dimensions are needed in headless mode
+			if (Renderer::pointerRenderer != NULL)
 			{
-				LOG_ERROR("Failed to convert the surface to a texture (%s).", SDL_GetError());
-				return -1;
+				_texturesInformations[i].pointerSDLTexture = SDL_CreateTextureFromSurface(Renderer::pointerRenderer, pointerSurface);
+				if (_texturesInformations[i].pointerSDLTexture == NULL)
+				{
+					LOG_ERROR("Failed to convert the surface to a texture (%s).", SDL_GetError());
+					SDL_FreeSurface(pointerSurface);
+					return -1;
+				}
 			}
 			
 			// Create the associated game texture (TODO even for animated textures ?)
-			_texturesInformations[i].pointerTexture = new Texture(_texturesInformations[i].pointerSDLTexture);
+			_texturesInformations[i].pointerTexture = new Texture(_texturesInformations[i].pointerSDLTexture, pointerSurface->w, pointerSurface->h);
+			SDL_FreeSurface(pointerSurface);
 			
 			LOG_DEBUG("Loaded texture. File name : %s, texture ID : %d, SDL texture pointer : %p.", _texturesInformations[i].pointerStringFileName, i, _texturesInformations[i].pointerSDLTexture);
 		}
@@ -1232,6 +1236,6 @@ namespace TextureManager
 		// Make sure the provided ID is valid
 		assert(id < TEXTURE_IDS_COUNT);
 		
-		return new AnimatedTexture(_texturesInformations[id].pointerSDLTexture, _texturesInformations[id].imagesCount, _texturesInformations[id].framesPerImageCount, isAnimationLooping);
+		return new AnimatedTexture(_texturesInformations[id].pointerSDLTexture, _texturesInformations[id].pointerTexture->getWidth(), _texturesInformations[id].pointerTexture->getHeight(), _texturesInformations[id].imagesCount, _texturesInformations[id].framesPerImageCount, isAnimationLooping);
 	}
 }